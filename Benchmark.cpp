@@ -0,0 +1,473 @@
+#include "headers/Benchmark.h"
+#include "headers/FlatAllocator.h"
+#include "headers/FrameAllocator.h"
+#include "headers/FramePool.h"
+#include "headers/Interpreter.h"
+#include "headers/PageReplacement.h"
+#include "headers/Process.h"
+#include "headers/RunQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <deque>
+#include <iomanip>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Dispatches per second with quantum-cycles 1: every core pops a process and
+ * immediately requeues it. Compares the old single readyQueue behind one
+ * mutex against per-core run queues with stealing.
+ */
+std::string Benchmark::runDispatchBenchmark() {
+  const int processesPerCore = 4;
+  const int durationMs = 500;
+  std::ostringstream report;
+  report << std::left << std::setw(8) << "Cores" << std::setw(22)
+         << "Global queue (/s)" << std::setw(22) << "Run queues (/s)"
+         << "Speedup\n";
+
+  for (int cores : {8, 32, 128}) {
+    double global = measureGlobalQueue(cores, processesPerCore, durationMs);
+    double local = measureRunQueues(cores, processesPerCore, durationMs);
+    report << std::left << std::setw(8) << cores << std::setw(22)
+           << static_cast<long long>(global) << std::setw(22)
+           << static_cast<long long>(local) << std::fixed
+           << std::setprecision(2) << local / global << "x\n";
+  }
+  return report.str();
+}
+
+double Benchmark::measureGlobalQueue(int cores, int processesPerCore,
+                                     int durationMs) {
+  std::deque<Process> processes; // stable addresses, Process is not movable
+  std::queue<Process *> readyQueue;
+  for (int i = 0; i < cores * processesPerCore; ++i) {
+    processes.emplace_back("Bench_" + std::to_string(i));
+    readyQueue.push(&processes.back());
+  }
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::atomic<bool> running = true;
+  std::atomic<long long> dispatches = 0;
+  std::vector<std::thread> threads;
+
+  for (int i = 0; i < cores; ++i) {
+    threads.emplace_back([&] {
+      long long local = 0;
+      while (running) {
+        Process *process;
+        {
+          std::unique_lock<std::mutex> lock(mtx);
+          cv.wait(lock, [&] { return !readyQueue.empty() || !running; });
+          if (!running) {
+            break;
+          }
+          process = readyQueue.front();
+          readyQueue.pop();
+        }
+        ++local;
+        {
+          std::lock_guard<std::mutex> lock(mtx);
+          readyQueue.push(process);
+        }
+        cv.notify_one();
+      }
+      dispatches += local;
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    running = false;
+  }
+  cv.notify_all();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return dispatches * 1000.0 / durationMs;
+}
+
+double Benchmark::measureRunQueues(int cores, int processesPerCore,
+                                   int durationMs) {
+  std::deque<Process> processes; // stable addresses, Process is not movable
+  std::vector<RunQueue> runQueues(cores);
+  for (int i = 0; i < cores * processesPerCore; ++i) {
+    processes.emplace_back("Bench_" + std::to_string(i));
+    runQueues[i % cores].push(&processes.back());
+  }
+
+  std::atomic<bool> running = true;
+  std::atomic<long long> dispatches = 0;
+  std::vector<std::thread> threads;
+
+  for (int i = 0; i < cores; ++i) {
+    threads.emplace_back([&, i] {
+      long long local = 0;
+      while (running) {
+        Process *process = runQueues[i].pop();
+        for (int j = 1; process == nullptr && j < cores; ++j) {
+          process = runQueues[(i + j) % cores].steal();
+        }
+        if (process == nullptr) {
+          std::this_thread::yield();
+          continue;
+        }
+        ++local;
+        runQueues[i].push(process);
+      }
+      dispatches += local;
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+  running = false;
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return dispatches * 1000.0 / durationMs;
+}
+
+/*
+ * Interpreted instructions per second on one core. "Batched" runs the
+ * interpreter loop with an unlimited budget; "per step" executes one
+ * instruction per call, which is how a core drives a process.
+ */
+std::string Benchmark::runInterpreterBenchmark() {
+  const int durationMs = 500;
+  std::ostringstream report;
+  report << std::left << std::setw(12) << "Mode"
+         << "Instructions/s per core\n";
+  report << std::left << std::setw(12) << "Batched"
+         << static_cast<long long>(measureInterpreter(INT_MAX, durationMs))
+         << "\n";
+  report << std::left << std::setw(12) << "Per step"
+         << static_cast<long long>(measureInterpreter(1, durationMs)) << "\n";
+  return report.str();
+}
+
+double Benchmark::measureInterpreter(int budget, int durationMs) {
+  Program program = Interpreter::generateProgram(1000000);
+  ExecutionState state;
+  state.printLog.reserve(program.printCount);
+
+  long long executed = 0;
+  auto start = std::chrono::steady_clock::now();
+  auto deadline = start + std::chrono::milliseconds(durationMs);
+  while (std::chrono::steady_clock::now() < deadline) {
+    for (int i = 0; i < 1000; ++i) {
+      if (state.finished) {
+        state = ExecutionState();
+        state.printLog.reserve(program.printCount);
+      }
+      executed += Interpreter::execute(program, state, budget);
+      state.sleepTicks = 0;
+    }
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return executed / elapsed.count();
+}
+
+/*
+ * Frames handed out or returned per second while processes of 1-64 pages come
+ * and go over 1M frames, with occupancy held around half. Compares the old
+ * free list (erase from the front) against FrameAllocator, taking frames one
+ * at a time and in one batch per process.
+ */
+std::string Benchmark::runFrameBenchmark() {
+  const int frameCount = 1 << 20;
+  const int durationMs = 500;
+  const char *modes[] = {"Free list", "Allocator", "Allocator (batch)"};
+  std::ostringstream report;
+  report << std::left << std::setw(20) << "Mode"
+         << "Frame operations/s\n";
+  for (int mode = 0; mode < 3; ++mode) {
+    report << std::left << std::setw(20) << modes[mode]
+           << static_cast<long long>(
+                  measureFrameChurn(frameCount, mode, durationMs))
+           << "\n";
+  }
+  return report.str();
+}
+
+double Benchmark::measureFrameChurn(int frameCount, int mode,
+                                    int durationMs) {
+  std::vector<int> freeFrameList;
+  for (int i = 1; i <= frameCount; ++i) {
+    freeFrameList.push_back(i);
+  }
+  FrameAllocator allocator(1, frameCount);
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> pageCount(1, 64);
+  std::vector<std::vector<int>> resident;
+  int used = 0;
+  long long operations = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  auto deadline = start + std::chrono::milliseconds(durationMs);
+  while (std::chrono::steady_clock::now() < deadline) {
+    for (int i = 0; i < 64; ++i) {
+      if (used < frameCount / 2) {
+        int pages = pageCount(rng);
+        std::vector<int> frames;
+        if (mode == 0) {
+          for (int j = 0; j < pages; ++j) {
+            frames.push_back(freeFrameList.front());
+            freeFrameList.erase(freeFrameList.begin());
+          }
+        } else if (mode == 1) {
+          for (int j = 0; j < pages; ++j) {
+            frames.push_back(allocator.allocate());
+          }
+        } else {
+          allocator.allocate(pages, frames);
+        }
+        used += pages;
+        operations += pages;
+        resident.push_back(std::move(frames));
+      } else {
+        size_t victim = rng() % resident.size();
+        std::swap(resident[victim], resident.back());
+        for (int frame : resident.back()) {
+          if (mode == 0) {
+            freeFrameList.push_back(frame);
+          } else {
+            allocator.release(frame);
+          }
+        }
+        used -= static_cast<int>(resident.back().size());
+        operations += static_cast<long long>(resident.back().size());
+        resident.pop_back();
+      }
+    }
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return operations / elapsed.count();
+}
+
+/*
+ * Replays one reference trace through every page replacement policy with
+ * 1024 frames. The trace mixes a skewed hot set of 2048 pages across eight
+ * processes with sequential scans over pages that are used once, the kind of
+ * traffic that separates recency from frequency.
+ */
+std::string Benchmark::runReplacementBenchmark() {
+  const int frameCount = 1024;
+  const int references = 2000000;
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::vector<uint64_t> trace;
+  trace.reserve(references);
+  uint64_t scanCursor = 0;
+  for (int i = 0; i < references; ++i) {
+    uint64_t pid = rng() % 8;
+    uint64_t page;
+    if (uniform(rng) < 0.75) {
+      double skew = uniform(rng);
+      page = static_cast<uint64_t>(skew * skew * 256);
+    } else {
+      page = 256 + scanCursor++ % 768;
+    }
+    trace.push_back(pid << 32 | page);
+  }
+
+  std::ostringstream report;
+  report << std::left << std::setw(8) << "Policy" << std::setw(14)
+         << "Hit ratio" << "ns/reference\n";
+  for (const char *name : {"fifo", "lru", "clock", "lfu", "arc"}) {
+    PageReplacementPolicy *policy =
+        PageReplacementPolicy::create(name, frameCount);
+    std::unordered_map<uint64_t, int> frameOf;
+    std::vector<uint64_t> pageIn(frameCount);
+    int used = 0;
+    long long hits = 0;
+    auto noPins = [](int) { return false; };
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t page : trace) {
+      auto it = frameOf.find(page);
+      if (it != frameOf.end()) {
+        hits++;
+        policy->pageReferenced(it->second);
+        continue;
+      }
+      int frame;
+      if (used < frameCount) {
+        frame = used++;
+      } else {
+        frame = policy->selectVictim(page, noPins);
+        frameOf.erase(pageIn[frame]);
+      }
+      pageIn[frame] = page;
+      frameOf[page] = frame;
+      policy->pageLoaded(frame, page);
+    }
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    delete policy;
+
+    std::ostringstream ratio;
+    ratio << std::fixed << std::setprecision(2) << 100.0 * hits / references
+          << "%";
+    report << std::left << std::setw(8) << name << std::setw(14)
+           << ratio.str() << std::fixed << std::setprecision(1)
+           << elapsed.count() / references << "\n";
+  }
+  return report.str();
+}
+
+/*
+ * Runs one stream of flat allocations (64-1024 KB) and frees over 16 MB of
+ * memory through each fit strategy. When an allocation fails, a random
+ * resident process is freed and the allocation retried. External
+ * fragmentation is the free memory left when an allocation fails, sampled
+ * over each quarter of the run.
+ */
+std::string Benchmark::runAllocationBenchmark() {
+  const int memorySize = 16384;
+  const int operations = 200000;
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> sizeOf(64, 1024);
+  std::vector<int> sizes(operations);
+  for (int &size : sizes) {
+    size = sizeOf(rng);
+  }
+
+  std::ostringstream report;
+  report << std::left << std::setw(11) << "Strategy" << std::setw(10)
+         << "ns/op" << std::setw(10) << "Failures"
+         << "Fragmentation at failure per quarter (KB)\n";
+  for (const char *strategy : {"first-fit", "next-fit", "best-fit",
+                               "worst-fit"}) {
+    FlatAllocator allocator(memorySize, strategy);
+    std::vector<int> resident; // start addresses
+    std::vector<long long> fragmentation(4, 0);
+    std::vector<int> failures(4, 0);
+    std::mt19937 releaseRng(7);
+
+    auto releaseRandom = [&] {
+      size_t victim = releaseRng() % resident.size();
+      allocator.release(resident[victim]);
+      resident[victim] = resident.back();
+      resident.pop_back();
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < operations; ++i) {
+      // free something now and then so holes appear all over memory
+      if (!resident.empty() && releaseRng() % 3 == 0) {
+        releaseRandom();
+      }
+      int address;
+      while ((address = allocator.allocate(sizes[i])) == -1) {
+        int quarter = i * 4 / operations;
+        failures[quarter]++;
+        fragmentation[quarter] += allocator.freeBytes();
+        releaseRandom();
+      }
+      resident.push_back(address);
+    }
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    int totalFailures = failures[0] + failures[1] + failures[2] + failures[3];
+    report << std::left << std::setw(11) << strategy << std::setw(10)
+           << std::fixed << std::setprecision(1) << elapsed.count() / operations
+           << std::setw(10) << totalFailures;
+    for (int quarter = 0; quarter < 4; ++quarter) {
+      report << std::setw(8)
+             << (failures[quarter] == 0
+                     ? 0
+                     : fragmentation[quarter] / failures[quarter]);
+    }
+    report << "\n";
+  }
+  return report.str();
+}
+
+/*
+ * Frame allocations per second with every core faulting pages in and freeing
+ * them again. Compares one FrameAllocator behind a single mutex, which is
+ * what the frame table lock amounted to, against a FramePool with a cache
+ * per core.
+ */
+std::string Benchmark::runFramePoolBenchmark() {
+  const int durationMs = 500;
+  std::ostringstream report;
+  report << std::left << std::setw(8) << "Cores" << std::setw(22)
+         << "Global lock (/s)" << std::setw(22) << "Frame pool (/s)"
+         << "Speedup\n";
+  for (int cores : {1, 4, 8}) {
+    double global = measureFramePool(cores, false, durationMs);
+    double pooled = measureFramePool(cores, true, durationMs);
+    report << std::left << std::setw(8) << cores << std::setw(22)
+           << static_cast<long long>(global) << std::setw(22)
+           << static_cast<long long>(pooled) << std::fixed
+           << std::setprecision(2) << pooled / global << "x\n";
+  }
+  return report.str();
+}
+
+double Benchmark::measureFramePool(int cores, bool sharded, int durationMs) {
+  const int frameCount = 4096;
+  FrameAllocator allocator(0, frameCount);
+  std::mutex allocatorMutex;
+  FramePool pool(frameCount, cores, std::min(frameCount / (4 * cores), 64));
+
+  std::atomic<bool> running = true;
+  std::atomic<long long> allocations = 0;
+  std::vector<std::thread> threads;
+  for (int core = 0; core < cores; ++core) {
+    threads.emplace_back([&, core] {
+      // each core keeps a working set of up to 16 frames and recycles them
+      std::vector<int> held;
+      long long local = 0;
+      while (running) {
+        if (held.size() < 16) {
+          int frame;
+          if (sharded) {
+            frame = pool.allocate(core);
+          } else {
+            std::lock_guard<std::mutex> lock(allocatorMutex);
+            frame = allocator.allocate();
+          }
+          if (frame != -1) {
+            held.push_back(frame);
+            ++local;
+          }
+          continue;
+        }
+        for (int frame : held) {
+          if (sharded) {
+            pool.release(core, frame);
+          } else {
+            std::lock_guard<std::mutex> lock(allocatorMutex);
+            allocator.release(frame);
+          }
+        }
+        held.clear();
+      }
+      allocations += local;
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+  running = false;
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return allocations * 1000.0 / durationMs;
+}
@@ -0,0 +1,134 @@
+#include "headers/BuddyAllocator.h"
+
+#include <algorithm>
+#include <bit>
+
+BuddyAllocator::BuddyAllocator(int memorySize)
+    : memorySize(std::max(memorySize, 0)),
+      freeHeads(std::bit_width(static_cast<unsigned>(this->memorySize)), -1),
+      nextFree(this->memorySize, -1), prevFree(this->memorySize, -1),
+      freeOrder(this->memorySize, -1), allocatedOrder(this->memorySize, -1),
+      requestedSize(this->memorySize, 0) {
+  // largest aligned power-of-two roots first
+  int start = 0;
+  while (start < this->memorySize) {
+    int order = std::bit_width(static_cast<unsigned>(this->memorySize - start)) -
+                1;
+    pushFree(start, order);
+    start += 1 << order;
+  }
+}
+
+int BuddyAllocator::orderFor(int size) {
+  return std::bit_width(static_cast<unsigned>(size - 1));
+}
+
+int BuddyAllocator::allocate(int size) {
+  if (size <= 0 || size > memorySize) {
+    return -1;
+  }
+  int order = orderFor(size);
+  int available = order;
+  while (available < static_cast<int>(freeHeads.size()) &&
+         freeHeads[available] == -1) {
+    available++;
+  }
+  if (available >= static_cast<int>(freeHeads.size())) {
+    return -1;
+  }
+
+  int start = freeHeads[available];
+  removeFree(start, available);
+  // split, handing the upper halves back
+  while (available > order) {
+    available--;
+    pushFree(start + (1 << available), available);
+  }
+  allocatedOrder[start] = static_cast<int8_t>(order);
+  requestedSize[start] = size;
+  usedTotal += 1 << order;
+  requestedTotal += size;
+  allocatedCount++;
+  return start;
+}
+
+void BuddyAllocator::release(int start) {
+  if (start < 0 || start >= memorySize || allocatedOrder[start] == -1) {
+    return;
+  }
+  int order = allocatedOrder[start];
+  allocatedOrder[start] = -1;
+  usedTotal -= 1 << order;
+  requestedTotal -= requestedSize[start];
+  requestedSize[start] = 0;
+  allocatedCount--;
+
+  // merge with the buddy for as long as it is free and whole
+  while (order + 1 < static_cast<int>(freeHeads.size())) {
+    int buddy = start ^ (1 << order);
+    if (buddy + (1 << order) > memorySize || freeOrder[buddy] != order) {
+      break;
+    }
+    removeFree(buddy, order);
+    start = std::min(start, buddy);
+    order++;
+  }
+  pushFree(start, order);
+}
+
+void BuddyAllocator::pushFree(int start, int order) {
+  freeOrder[start] = static_cast<int8_t>(order);
+  prevFree[start] = -1;
+  nextFree[start] = freeHeads[order];
+  if (freeHeads[order] != -1) {
+    prevFree[freeHeads[order]] = start;
+  }
+  freeHeads[order] = start;
+}
+
+void BuddyAllocator::removeFree(int start, int order) {
+  if (prevFree[start] != -1) {
+    nextFree[prevFree[start]] = nextFree[start];
+  } else {
+    freeHeads[order] = nextFree[start];
+  }
+  if (nextFree[start] != -1) {
+    prevFree[nextFree[start]] = prevFree[start];
+  }
+  freeOrder[start] = -1;
+}
+
+std::vector<BuddyAllocator::Block> BuddyAllocator::blocks() const {
+  std::vector<Block> result;
+  for (int start = 0; start < memorySize;) {
+    bool free = freeOrder[start] != -1;
+    int size = 1 << (free ? freeOrder[start] : allocatedOrder[start]);
+    result.push_back({start, size, free ? 0 : requestedSize[start]});
+    start += size;
+  }
+  return result;
+}
+
+int BuddyAllocator::usedBytes() const { return usedTotal; }
+
+int BuddyAllocator::freeBytes() const { return memorySize - usedTotal; }
+
+int BuddyAllocator::internalFragmentation() const {
+  return usedTotal - requestedTotal;
+}
+
+int BuddyAllocator::largestFreeBlock() const {
+  for (int order = static_cast<int>(freeHeads.size()) - 1; order >= 0;
+       --order) {
+    if (freeHeads[order] != -1) {
+      return 1 << order;
+    }
+  }
+  return 0;
+}
+
+int BuddyAllocator::externalFragmentation() const {
+  return freeBytes() - largestFreeBlock();
+}
+
+int BuddyAllocator::allocatedBlockCount() const { return allocatedCount; }
@@ -1,5 +1,7 @@
 #include "headers/Config.h"
 
+#include <algorithm>
+
 Config::Config(const std::string &filename) : filename(filename) {}
 
 void Config::loadConfig() {
@@ -49,11 +51,69 @@ void Config::parseLine(const std::string &line) {
         minMemoryPerProcess = std::stoi(value);
       }else if (key == "max-mem-per-proc") {
         maxMemoryPerProcess = std::stoi(value);
+      } else if (key == "mlfq-levels") {
+        mlfqLevels = std::stoi(value);
+      } else if (key == "mlfq-quantums") {
+        // comma separated, one quantum per level: 2,4,8
+        mlfqQuantums = parseList(value);
+      } else if (key == "mlfq-boost-interval") {
+        mlfqBoostInterval = std::stoi(value);
+      } else if (key == "min-deadline") {
+        minDeadline = std::stoi(value);
+      } else if (key == "max-deadline") {
+        maxDeadline = std::stoi(value);
+      } else if (key == "tenant-tickets") {
+        // comma separated, one ticket count per tenant: 100,200,300
+        tenantTickets = parseList(value);
+        if (tenantTickets.empty()) {
+          tenantTickets.push_back(100);
+        }
+      } else if (key == "sim-mode") {
+        simMode = unquote(value);
+      } else if (key == "paging-mode") {
+        pagingMode = unquote(value);
+      } else if (key == "page-replacement") {
+        pageReplacement = unquote(value);
+      } else if (key == "allocation-strategy") {
+        allocationStrategy = unquote(value);
+      } else if (key == "memory-mode") {
+        memoryMode = unquote(value);
+      } else if (key == "compaction-threshold") {
+        compactionThreshold = std::stoi(value);
+      } else if (key == "compaction-rate") {
+        compactionRate = std::stoi(value);
+      } else if (key == "swap-size") {
+        swapSize = std::stoi(value);
+      } else if (key == "swap-mmap") {
+        swapMmap = std::stoi(value) != 0;
+      } else if (key == "swap-latency") {
+        swapLatency = std::stoi(value);
+      } else if (key == "max-resident-procs") {
+        maxResidentProcs = std::stoi(value);
       }
 
     }
   }
 }
+std::vector<int> Config::parseList(const std::string &value) {
+  std::stringstream list(value);
+  std::string item;
+  std::vector<int> numbers;
+  while (std::getline(list, item, ',')) {
+    if (!item.empty()) {
+      numbers.push_back(std::stoi(item));
+    }
+  }
+  return numbers;
+}
+
+std::string Config::unquote(const std::string &value) {
+  if (value.size() >= 2 && value.front() == '\"' && value.back() == '\"') {
+    return value.substr(1, value.size() - 2);
+  }
+  return value;
+}
+
 void Config::displayConfig() const {
   std::cout << "Number of CPUs: " << numCpu << std::endl;
   std::cout << "Scheduler: " << scheduler << std::endl;
@@ -66,6 +126,47 @@ void Config::displayConfig() const {
   std::cout << "Memory Per Frame: " << memoryPerFrame << std::endl;
   std::cout << "Min Memory Per Process: " << minMemoryPerProcess << std::endl;
   std::cout << "Max Memory Per Process: " << maxMemoryPerProcess << std::endl;
+  std::cout << "Simulation Mode: " << simMode << std::endl;
+  std::cout << "Memory Mode: " << getMemoryMode() << std::endl;
+  std::cout << "Paging Mode: " << pagingMode << std::endl;
+  std::cout << "Allocation Strategy: " << allocationStrategy << std::endl;
+  if (getMemoryMode() == "flat") {
+    std::cout << "Compaction: " << compactionThreshold << "% threshold, "
+              << compactionRate << " KB per tick" << std::endl;
+  }
+  if (getMemoryMode() == "paging") {
+    std::cout << "Swap Size: " << swapSize << " KB"
+              << (swapMmap ? " (mmap)" : "") << std::endl;
+    if (simMode == "virtual") {
+      std::cout << "Swap Latency: " << swapLatency << " ticks" << std::endl;
+    }
+  }
+  if (maxResidentProcs > 0) {
+    std::cout << "Max Resident Processes: " << maxResidentProcs << std::endl;
+  }
+  if (pagingMode == "demand") {
+    std::cout << "Page Replacement: " << pageReplacement << std::endl;
+  }
+  if (maxDeadline > 0) {
+    std::cout << "Deadline Range: " << minDeadline << "-" << maxDeadline
+              << " ticks" << std::endl;
+  }
+  if (tenantTickets.size() > 1 || scheduler == "stride") {
+    std::cout << "Tenant Tickets:";
+    for (int tickets : tenantTickets) {
+      std::cout << " " << tickets;
+    }
+    std::cout << std::endl;
+  }
+  if (scheduler == "mlfq") {
+    std::cout << "MLFQ Levels: " << mlfqLevels << std::endl;
+    std::cout << "MLFQ Quantums:";
+    for (int quantum : getMlfqQuantums()) {
+      std::cout << " " << quantum;
+    }
+    std::cout << std::endl;
+    std::cout << "MLFQ Boost Interval: " << mlfqBoostInterval << std::endl;
+  }
 }
 int Config::getNumCpu() const { return numCpu; }
 
@@ -89,3 +190,58 @@ int Config::getMemoryPerProcess() const { return memoryPerProcess; }
 
 int Config::getMinMemoryPerProcess() const { return minMemoryPerProcess; }
 int Config::getMaxMemoryPerProcess() const { return maxMemoryPerProcess; }
+
+std::string Config::getSimMode() const { return simMode; }
+
+int Config::getMlfqLevels() const { return mlfqLevels; }
+
+std::vector<int> Config::getMlfqQuantums() const {
+  std::vector<int> quantums = mlfqQuantums;
+  // unlisted levels repeat the last quantum, or double quantum-cycles per
+  // level when no list is given
+  for (int level = quantums.size(); level < mlfqLevels; ++level) {
+    quantums.push_back(quantums.empty() || mlfqQuantums.empty()
+                           ? quantumCycles << std::min(level, 16)
+                           : quantums.back());
+  }
+  quantums.resize(std::max(mlfqLevels, 1));
+  return quantums;
+}
+
+int Config::getMlfqBoostInterval() const { return mlfqBoostInterval; }
+
+int Config::getMinDeadline() const { return minDeadline; }
+
+int Config::getMaxDeadline() const { return maxDeadline; }
+
+std::vector<int> Config::getTenantTickets() const { return tenantTickets; }
+
+std::string Config::getPagingMode() const { return pagingMode; }
+
+std::string Config::getPageReplacement() const { return pageReplacement; }
+
+std::string Config::getAllocationStrategy() const {
+  return allocationStrategy;
+}
+
+int Config::getCompactionThreshold() const { return compactionThreshold; }
+
+int Config::getCompactionRate() const { return compactionRate; }
+
+int Config::getSwapSize() const { return swapSize; }
+
+bool Config::getSwapMmap() const { return swapMmap; }
+
+int Config::getSwapLatency() const { return swapLatency; }
+
+int Config::getMaxResidentProcs() const { return maxResidentProcs; }
+
+// Without a valid memory-mode the old rule applies: one frame spanning all of
+// memory means flat allocation, anything else paging.
+std::string Config::getMemoryMode() const {
+  if (memoryMode == "flat" || memoryMode == "paging" ||
+      memoryMode == "buddy") {
+    return memoryMode;
+  }
+  return maxOverallMemory == memoryPerFrame ? "flat" : "paging";
+}
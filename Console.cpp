@@ -19,6 +19,7 @@
 #endif
 
 // #include "ScreenCommand.h"
+#include "headers/Benchmark.h"
 #include "headers/Config.h"
 #include "headers/Scheduler.h"
 #include <algorithm>
@@ -82,6 +83,7 @@ void Console::displayMainMenu() {
   std::cout << "  'scheduler-test' - Test the scheduler\n";
   std::cout << "  'scheduler-stop' - Stop the scheduler\n";
   std::cout << "  'report-util'    - Run report utility\n";
+  std::cout << "  'benchmark'      - Run scheduler micro-benchmarks\n";
   std::cout << "  'clear'          - Clear the screen\n";
   std::cout << "  'exit'           - Exit the application\n";
 }
@@ -92,6 +94,31 @@ void Console::processSMI(Process &process) {
             << "Current instruction lines: " << process.getInstructionsDone()
             << "\n"
             << "Lines of code: " << process.getInstructionsTotal();
+  if (process.demandPaged) {
+    double faultRate =
+        process.memoryReferences == 0
+            ? 0.0
+            : 100.0 * process.pageFaults / process.memoryReferences;
+    std::ostringstream rate;
+    rate << std::fixed << std::setprecision(2) << faultRate;
+    std::cout << "\nPage faults: " << process.pageFaults << " (" << rate.str()
+              << "% of references)"
+              << "\nResident set: " << process.residentPages * process.pageSize
+              << " KB";
+  }
+
+  std::span<const PrintRecord> printLog = process.getPrintLog();
+  size_t printed = printLog.size();
+  if (printed > 0) {
+    std::cout << "\n\nLogs:";
+    for (size_t i = printed > 10 ? printed - 10 : 0; i < printed; ++i) {
+      if (printLog[i].hasValue) {
+        std::cout << "\nValue from: " << printLog[i].value;
+      } else {
+        std::cout << "\nHello world from " << process.getProcessName() << "!";
+      }
+    }
+  }
 }
 
 std::string Console::generateReport() {
@@ -99,9 +126,11 @@ std::string Console::generateReport() {
   int cpuUtil = 0;
   int coreUsed = 0;
   int coreAvailable = 0;
+  // one consistent copy of the cores, published by the scheduler
+  std::vector<CoreStatus> cores = scheduler->getStatusBoard()->readCores();
 
-  for (const auto &core : *coreVector) {
-    if (core.state == CoreState::IDLE) {
+  for (const auto &core : cores) {
+    if (!core.running) {
       coreAvailable++;
     } else {
       coreUsed++;
@@ -111,35 +140,41 @@ std::string Console::generateReport() {
 
   report << "CPU utiliziation: " << cpuUtil << "%";
   report << "\nCores used: " << coreUsed;
-  report << "\nCores available: " << coreAvailable << "\n";
+  report << "\nCores available: " << coreAvailable;
+  report << "\nAverage waiting time: " << scheduler->getAverageWaitingTime()
+         << " ticks";
+  report << "\nAverage turnaround time: "
+         << scheduler->getAverageTurnaroundTime() << " ticks";
+  report << "\nMissed deadlines: " << scheduler->getMissedDeadlines();
+  report << "\nRejected processes: " << scheduler->getRejectedProcesses()
+         << "\n";
+  report << scheduler->getTenantShares();
   report << "-----------------------------------------------------------\n";
 
   report << "\n\nRunning Processes: \n";
 
-  for (const auto &core : *coreVector) {
-    if (core.state == CoreState::RUNNING) {
+  for (const auto &core : cores) {
+    if (core.process != nullptr) {
       report << core.process->getProcessName() << "\t("
-             << std::put_time(std::localtime(&core.process->startTime),
+             << std::put_time(std::localtime(&core.startTime),
                               "%Y-%m-%d %H:%M:%S")
-             << ")\t Core: " << core.process->getCoreAssigned() << "\t "
-             << core.process->getInstructionsDone() << "/"
-             << core.process->getInstructionsTotal() << "\n";
-    } else {
+             << ")\t Core: " << core.coreIndex << "\t "
+             << core.instructionsDone << "/" << core.instructionsTotal << "\n";
+    } else if (!core.running) {
       // print "CPU {} Idle"
       report << "CPU " << core.coreIndex << " Idle\n";
     }
   }
 
   report << "\n\nFinished Processes: \n";
-  for (const auto &process : *processVector) {
-    if (process->getDone() == true) {
-      report << process->getProcessName() << "\t ("
-             << std::put_time(std::localtime(&process->startTime),
-                              "%Y-%m-%d %H:%M:%S")
-             << ")\t Status: Finished"
-             << "\t " << process->getInstructionsDone() << "/"
-             << process->getInstructionsTotal() << "\n";
-    }
+  for (const FinishedRecord *process :
+       scheduler->getStatusBoard()->readFinished()) {
+    report << process->processName << "\t ("
+           << std::put_time(std::localtime(&process->startTime),
+                            "%Y-%m-%d %H:%M:%S")
+           << ")\t Status: Finished"
+           << "\t " << process->instructionsDone << "/"
+           << process->instructionsTotal << "\n";
   }
   // }
   report << "-----------------------------------------------------------\n";
@@ -148,8 +183,18 @@ std::string Console::generateReport() {
 
 void Console::processCommand(const std::string &command, bool &session) {
   std::stringstream ss(command);
-  std::string cmd, option, screenName;
+  std::string cmd, option, screenName, flag;
   ss >> cmd >> option >> screenName;
+  // screen -s <name> [-d <deadline ticks>] [-t <tenant>]
+  int deadline = 0;
+  int tenant = 0;
+  while (ss >> flag) {
+    if (flag == "-d") {
+      ss >> deadline;
+    } else if (flag == "-t") {
+      ss >> tenant;
+    }
+  }
 
   // bool started = false;
 
@@ -224,16 +269,21 @@ void Console::processCommand(const std::string &command, bool &session) {
         auto item = std::find(existingSessions.begin(), existingSessions.end(),
                               screenName);
         if (item == existingSessions.end()) {
+          Process *newProcess = new Process(screenName);
+          newProcess->setScreenName(screenName);
+          newProcess->setProgram(Interpreter::generateProgram(
+              rand() % (maxins - minins + 1) + minins));
+          newProcess->relativeDeadline = std::max(deadline, 0);
+          newProcess->tenant = tenant;
+          if (!scheduler->addCustomProcess(newProcess)) {
+            std::cout << "Process rejected: its deadline cannot be met";
+            delete newProcess;
+            return;
+          }
           session = true;
           sessionName = screenName;
           existingSessions.push_back(sessionName);
-
-          Process *newProcess = new Process(screenName);
           currentSessionProcess = newProcess;
-          newProcess->setScreenName(screenName);
-          newProcess->setInstructionsTotal(rand() % (maxins - minins + 1) +
-                                           minins);
-          scheduler->addCustomProcess(newProcess);
           clearScreen();
           processSMI(*currentSessionProcess);
         } else {
@@ -281,6 +331,23 @@ void Console::processCommand(const std::string &command, bool &session) {
       std::cout << "Something went wrong while opening the file!!" << std::endl;
     }
 
+  } else if (cmd == "benchmark") {
+    if (option == "dispatch") {
+      std::cout << Benchmark::runDispatchBenchmark();
+    } else if (option == "interpreter") {
+      std::cout << Benchmark::runInterpreterBenchmark();
+    } else if (option == "frames") {
+      std::cout << Benchmark::runFrameBenchmark();
+    } else if (option == "replacement") {
+      std::cout << Benchmark::runReplacementBenchmark();
+    } else if (option == "allocation") {
+      std::cout << Benchmark::runAllocationBenchmark();
+    } else if (option == "pool") {
+      std::cout << Benchmark::runFramePoolBenchmark();
+    } else {
+      std::cout << "Usage: benchmark "
+                   "<dispatch|interpreter|frames|replacement|allocation|pool>\n";
+    }
   } else if (command == "clear") {
     clearScreen();
     displayMainMenu();
@@ -291,20 +358,14 @@ void Console::processCommand(const std::string &command, bool &session) {
   } else if (command == "process-smi") {
     /*std::unordered_map<int, MemoryManager::Frame> tempProcessFrameMap =*/
     /*    scheduler->getMemoryManager().processFrameMap;*/
-    std::string type;
-
-    if (maxOverallMem == memPerFrame) {
-      type = "flat";
-    } else {
-      type = "paging";
-    }
+    std::string type = scheduler->getMemoryMode();
 
     int cpuUtil = 0;
     int coreUsed = 0;
     int coreAvailable = 0;
 
-    for (const auto &core : *coreVector) {
-      if (core.state == CoreState::IDLE) {
+    for (const auto &core : scheduler->getStatusBoard()->readCores()) {
+      if (!core.running) {
         coreAvailable++;
       } else {
         coreUsed++;
@@ -324,28 +385,89 @@ void Console::processCommand(const std::string &command, bool &session) {
               << scheduler->getMemoryManager()->maxMemory << "MiB\n";
     std::cout << "Memory Util: "
               << scheduler->getMemoryManager()->getMemoryUtil(type) << "%\n";
+    std::cout << "Processes in memory: "
+              << scheduler->getMemoryManager()->getResidentProcessCount()
+              << "\n";
     std::cout
         << "============================================================\n";
     std::cout << "Running Processes and Memory Usage: \n"
               << scheduler->getMemoryManager()->getProcessMemoryBlocks();
   } else if (command == "vmstat") {
-    std::string type;
-    if (maxOverallMem == memPerFrame) {
-      type = "flat";
-    } else {
-      type = "paging";
-    }
+    std::string type = scheduler->getMemoryMode();
     std::cout << maxOverallMem << "K TOTAL MEMORY\n";
     std::cout << scheduler->getMemoryManager()->getMemoryUsage(type)
               << "K USED MEMORY\n";
     std::cout << scheduler->getMemoryManager()->getFreeMemory(type)
               << "K FREE MEMORY\n";
+    if (type == "flat" || type == "buddy") {
+      MemoryManager *memory = scheduler->getMemoryManager();
+      std::cout << memory->calculateExternalFragmentation()
+                << "K EXTERNAL FRAGMENTATION ("
+                << static_cast<int>(memory->getAverageFragmentation())
+                << "K average, " << memory->fragmentationPeak
+                << "K peak over memory stamps)\n";
+      if (type == "buddy") {
+        std::cout << memory->getInternalFragmentation()
+                  << "K INTERNAL FRAGMENTATION\n";
+      }
+      std::cout << memory->failedAllocations << " Failed allocations\n";
+      if (type == "flat") {
+        std::cout << memory->compactedBytes << "K compacted in "
+                  << memory->compactionMoves << " block moves ("
+                  << memory->compactionPasses << " passes), "
+                  << memory->rescuedAllocations
+                  << " allocations rescued\n";
+      }
+    }
+    std::cout << scheduler->getBlockedCount() << " Blocked processes\n";
+    std::cout << scheduler->getResidentCount() << " Resident processes, "
+              << scheduler->getMemoryWaitCount() << " waiting for memory\n";
     std::cout << scheduler->idleTicks << " Idle CPU ticks\n";
     std::cout << scheduler->activeTicks << " Active CPU ticks\n";
     std::cout << scheduler->idleTicks + scheduler->activeTicks
               << " Total ticks\n";
+    if (scheduler->isVirtualMode()) {
+      std::cout << scheduler->getCurrentCycle() << " Simulated cycles\n";
+    }
+    std::cout << scheduler->getAverageWaitingTime()
+              << " Average waiting ticks\n";
+    std::cout << scheduler->getAverageTurnaroundTime()
+              << " Average turnaround ticks\n";
+    std::cout << scheduler->getMissedDeadlines() << " Missed deadlines\n";
+    std::cout << scheduler->getRejectedProcesses()
+              << " Rejected by admission control\n";
+    std::cout << scheduler->getTenantShares();
+    std::cout << scheduler->getStampRecorder().stampsWritten
+              << " Memory stamps written ("
+              << scheduler->getStampRecorder().bytesWritten << " bytes)\n";
     std::cout << scheduler->getMemoryManager()->pagedIns << " Num paged in\n";
     std::cout << scheduler->getMemoryManager()->pagedOuts << " Num paged out\n";
+    std::cout << scheduler->getMemoryManager()->pageFaults << " Page faults\n";
+    if (type == "paging") {
+      MemoryManager *memory = scheduler->getMemoryManager();
+      std::cout << memory->swapSpace.usedSlots() << "/"
+                << memory->swapSpace.totalSlots() << " Swap slots used ("
+                << memory->swapWrites << " pages written, "
+                << memory->swapReads << " read back)\n";
+      if (memory->swapIo != nullptr) {
+        std::cout << memory->swapIo->pagesWritten << " pages written in "
+                  << memory->swapIo->writeCalls << " writes, "
+                  << memory->swapIo->batches << " swap I/O batches\n";
+      }
+    }
+    if (scheduler->getMemoryManager()->pageReferences > 0) {
+      MemoryManager *memory = scheduler->getMemoryManager();
+      uint64_t misses = memory->pageFaults;
+      uint64_t hits = memory->pageReferences > misses
+                          ? memory->pageReferences - misses
+                          : 0;
+      std::ostringstream ratio;
+      ratio << std::fixed << std::setprecision(2)
+            << 100.0 * hits / memory->pageReferences;
+      std::cout << memory->pageReplacement << " replacement: " << hits
+                << " hits, " << misses << " misses (" << ratio.str()
+                << "% hit ratio)\n";
+    }
   } else {
     std::cout << "Unknown command. Try again.\n";
   }
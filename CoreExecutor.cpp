@@ -0,0 +1,80 @@
+#include "headers/CoreExecutor.h"
+
+CoreExecutor::CoreExecutor(int numCores, int numWorkers,
+                           std::function<bool(int)> stepFunction,
+                           std::chrono::milliseconds execDelay)
+    : numCores(numCores), numWorkers(numWorkers),
+      stepFunction(std::move(stepFunction)), execDelay(execDelay) {}
+
+void CoreExecutor::start() {
+  {
+    std::lock_guard<std::mutex> lock(executorMutex);
+    running = true;
+    // every core starts parked; work arriving wakes them one at a time
+    for (int i = numCores - 1; i >= 0; --i) {
+      parkedCores.push_back(i);
+    }
+  }
+  for (int i = 0; i < numWorkers; ++i) {
+    workers.emplace_back(&CoreExecutor::workerLoop, this);
+    workers.back().detach();
+  }
+}
+
+void CoreExecutor::wakeOne() {
+  {
+    std::lock_guard<std::mutex> lock(executorMutex);
+    if (parkedCores.empty()) {
+      // a core that is mid-step will pick this up instead of parking
+      pendingWakes = std::min(pendingWakes + 1, numCores);
+      return;
+    }
+    timers.push({Clock::now(), parkedCores.back()});
+    parkedCores.pop_back();
+  }
+  executorCv.notify_one();
+}
+
+void CoreExecutor::stop() {
+  {
+    std::lock_guard<std::mutex> lock(executorMutex);
+    running = false;
+  }
+  executorCv.notify_all();
+}
+
+int CoreExecutor::getWorkerCount() const { return numWorkers; }
+
+void CoreExecutor::workerLoop() {
+  std::unique_lock<std::mutex> lock(executorMutex);
+  while (running) {
+    if (timers.empty()) {
+      executorCv.wait(lock);
+      continue;
+    }
+    Clock::time_point due = timers.top().due;
+    if (due > Clock::now()) {
+      executorCv.wait_until(lock, due);
+      continue;
+    }
+    int coreIndex = timers.top().coreIndex;
+    timers.pop();
+    if (!timers.empty()) {
+      // let another worker take the next due core while this one steps
+      executorCv.notify_one();
+    }
+
+    lock.unlock();
+    bool worked = stepFunction(coreIndex);
+    lock.lock();
+
+    if (worked) {
+      timers.push({Clock::now() + execDelay, coreIndex});
+    } else if (pendingWakes > 0) {
+      pendingWakes--;
+      timers.push({Clock::now(), coreIndex});
+    } else {
+      parkedCores.push_back(coreIndex);
+    }
+  }
+}
@@ -0,0 +1,15 @@
+#include "headers/EventQueue.h"
+
+void EventQueue::schedule(uint64_t tick, SimEventType type, int coreIndex) {
+  events.push({tick, nextSequence++, type, coreIndex});
+}
+
+SimEvent EventQueue::pop() {
+  SimEvent event = events.top();
+  events.pop();
+  return event;
+}
+
+bool EventQueue::empty() const { return events.empty(); }
+
+size_t EventQueue::size() const { return events.size(); }
@@ -0,0 +1,205 @@
+#include "headers/FlatAllocator.h"
+
+#include <algorithm>
+
+FlatAllocator::FreeBlockTree::FreeBlockTree(int addresses) : leaves(1) {
+  while (leaves < addresses) {
+    leaves <<= 1;
+  }
+  tree.assign(2 * leaves, 0);
+}
+
+void FlatAllocator::FreeBlockTree::set(int address, int size) {
+  int node = leaves + address;
+  tree[node] = size;
+  for (node >>= 1; node > 0; node >>= 1) {
+    tree[node] = std::max(tree[2 * node], tree[2 * node + 1]);
+  }
+}
+
+int FlatAllocator::FreeBlockTree::findFirst(int from, int size) const {
+  return findFirst(1, 0, leaves - 1, from, size);
+}
+
+int FlatAllocator::FreeBlockTree::findFirst(int node, int low, int high,
+                                            int from, int size) const {
+  if (high < from || tree[node] < size) {
+    return -1;
+  }
+  if (low == high) {
+    return low;
+  }
+  int middle = (low + high) / 2;
+  int found = findFirst(2 * node, low, middle, from, size);
+  if (found == -1) {
+    found = findFirst(2 * node + 1, middle + 1, high, from, size);
+  }
+  return found;
+}
+
+FlatAllocator::FlatAllocator(int memorySize, const std::string &strategy)
+    : strategy(isKnownStrategy(strategy) ? strategy : "first-fit"),
+      memorySize(memorySize), freeByAddress(std::max(memorySize, 1)) {
+  if (memorySize > 0) {
+    blockMap[0] = {memorySize, true};
+    addFree(0, memorySize);
+  }
+}
+
+bool FlatAllocator::isKnownStrategy(const std::string &strategy) {
+  return strategy == "first-fit" || strategy == "next-fit" ||
+         strategy == "best-fit" || strategy == "worst-fit";
+}
+
+int FlatAllocator::findFit(int size) {
+  if (strategy == "best-fit") {
+    auto it = freeBySize.lower_bound({size, -1});
+    return it == freeBySize.end() ? -1 : it->second;
+  }
+  if (strategy == "worst-fit") {
+    if (freeBySize.empty() || freeBySize.rbegin()->first < size) {
+      return -1;
+    }
+    return freeBySize.rbegin()->second;
+  }
+  if (strategy == "next-fit") {
+    int start = freeByAddress.findFirst(nextFitStart, size);
+    return start != -1 ? start : freeByAddress.findFirst(0, size);
+  }
+  return freeByAddress.findFirst(0, size);
+}
+
+int FlatAllocator::allocate(int size) {
+  if (size <= 0) {
+    return -1;
+  }
+  int start = findFit(size);
+  if (start == -1) {
+    return -1;
+  }
+
+  int blockSize = blockMap[start].first;
+  removeFree(start, blockSize);
+  blockMap[start] = {size, false};
+  if (blockSize > size) {
+    blockMap[start + size] = {blockSize - size, true};
+    addFree(start + size, blockSize - size);
+  }
+  nextFitStart = (start + size) % std::max(memorySize, 1);
+  allocatedCount++;
+  return start;
+}
+
+void FlatAllocator::release(int start) {
+  auto it = blockMap.find(start);
+  if (it == blockMap.end() || it->second.second) {
+    return;
+  }
+  int size = it->second.first;
+  allocatedCount--;
+
+  auto next = std::next(it);
+  if (next != blockMap.end() && next->second.second) {
+    removeFree(next->first, next->second.first);
+    size += next->second.first;
+    blockMap.erase(next);
+  }
+  if (it != blockMap.begin()) {
+    auto prev = std::prev(it);
+    if (prev->second.second) {
+      removeFree(prev->first, prev->second.first);
+      prev->second.first += size;
+      blockMap.erase(it);
+      addFree(prev->first, prev->second.first);
+      return;
+    }
+  }
+  it->second = {size, true};
+  addFree(start, size);
+}
+
+int FlatAllocator::nextSlideSize() const {
+  int hole = freeByAddress.findFirst(0, 1);
+  if (hole == -1) {
+    return 0;
+  }
+  auto next = blockMap.upper_bound(hole);
+  return next == blockMap.end() ? 0 : next->second.first;
+}
+
+int FlatAllocator::slideDown(int &from, int &to) {
+  int hole = freeByAddress.findFirst(0, 1);
+  if (hole == -1) {
+    return 0;
+  }
+  auto it = blockMap.find(hole);
+  auto next = std::next(it);
+  if (next == blockMap.end()) {
+    return 0;
+  }
+  // free blocks are always coalesced, so next is allocated
+  int holeSize = it->second.first;
+  int size = next->second.first;
+  from = next->first;
+  to = hole;
+  removeFree(hole, holeSize);
+  blockMap.erase(next);
+  it->second = {size, false};
+
+  int freeStart = hole + size;
+  int freeSize = holeSize;
+  auto after = blockMap.find(freeStart + freeSize);
+  if (after != blockMap.end() && after->second.second) {
+    removeFree(after->first, after->second.first);
+    freeSize += after->second.first;
+    blockMap.erase(after);
+  }
+  blockMap[freeStart] = {freeSize, true};
+  addFree(freeStart, freeSize);
+  return size;
+}
+
+void FlatAllocator::addFree(int start, int size) {
+  freeBySize.insert({size, start});
+  freeByAddress.set(start, size);
+  freeTotal += size;
+}
+
+void FlatAllocator::removeFree(int start, int size) {
+  freeBySize.erase({size, start});
+  freeByAddress.set(start, 0);
+  freeTotal -= size;
+}
+
+std::vector<FlatAllocator::Block> FlatAllocator::blocks() const {
+  std::vector<Block> result;
+  result.reserve(blockMap.size());
+  for (const auto &[start, block] : blockMap) {
+    result.push_back({start, block.first, block.second});
+  }
+  return result;
+}
+
+int FlatAllocator::freeBytes() const { return freeTotal; }
+
+int FlatAllocator::usedBytes() const { return memorySize - freeTotal; }
+
+int FlatAllocator::largestFreeBlock() const {
+  return freeBySize.empty() ? 0 : freeBySize.rbegin()->first;
+}
+
+int FlatAllocator::freeBlockCount() const {
+  return static_cast<int>(freeBySize.size());
+}
+
+int FlatAllocator::externalFragmentation() const {
+  return freeTotal - largestFreeBlock();
+}
+
+int FlatAllocator::fragmentationPercent() const {
+  return freeTotal == 0 ? 0 : externalFragmentation() * 100 / freeTotal;
+}
+
+int FlatAllocator::allocatedBlockCount() const { return allocatedCount; }
+
+const std::string &FlatAllocator::getStrategy() const { return strategy; }
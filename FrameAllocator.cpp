@@ -0,0 +1,65 @@
+#include "headers/FrameAllocator.h"
+
+#include <cstddef>
+
+FrameAllocator::FrameAllocator(int firstFrame, int frameCount)
+    : firstFrame(firstFrame), freeFlags(frameCount, 1) {
+  freeStack.reserve(frameCount);
+  for (int i = frameCount - 1; i >= 0; --i) {
+    freeStack.push_back(firstFrame + i);
+  }
+}
+
+int FrameAllocator::allocate() {
+  if (freeStack.empty()) {
+    return -1;
+  }
+  int frame = freeStack.back();
+  freeStack.pop_back();
+  freeFlags[frame - firstFrame] = 0;
+  return frame;
+}
+
+bool FrameAllocator::allocate(int count, std::vector<int> &frames) {
+  if (count < 0 || freeStack.size() < static_cast<size_t>(count)) {
+    return false;
+  }
+  auto begin = freeStack.end() - count;
+  for (auto it = freeStack.end(); it != begin;) {
+    --it;
+    freeFlags[*it - firstFrame] = 0;
+    frames.push_back(*it);
+  }
+  freeStack.erase(begin, freeStack.end());
+  return true;
+}
+
+void FrameAllocator::release(int frame) {
+  int index = frame - firstFrame;
+  if (index < 0 || index >= static_cast<int>(freeFlags.size()) ||
+      freeFlags[index]) {
+    return;
+  }
+  freeFlags[index] = 1;
+  freeStack.push_back(frame);
+}
+
+void FrameAllocator::release(const std::vector<int> &frames) {
+  for (int frame : frames) {
+    release(frame);
+  }
+}
+
+bool FrameAllocator::isFree(int frame) const {
+  int index = frame - firstFrame;
+  return index >= 0 && index < static_cast<int>(freeFlags.size()) &&
+         freeFlags[index];
+}
+
+int FrameAllocator::freeCount() const {
+  return static_cast<int>(freeStack.size());
+}
+
+int FrameAllocator::totalCount() const {
+  return static_cast<int>(freeFlags.size());
+}
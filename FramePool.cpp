@@ -0,0 +1,126 @@
+#include "headers/FramePool.h"
+
+#include <algorithm>
+
+FramePool::FramePool(int frameCount, int shardCount, int cacheSize)
+    : global(0, std::max(frameCount, 0)), shards(std::max(shardCount, 1)),
+      cacheSize(std::max(cacheSize, 1)), frameCount(std::max(frameCount, 0)),
+      freeFrames(std::max(frameCount, 0)) {}
+
+int FramePool::allocate(int shard) {
+  if (freeFrames == 0) {
+    return -1;
+  }
+  Shard &local = shardFor(shard);
+  {
+    std::lock_guard<std::mutex> lock(local.mutex);
+    if (local.frames.empty()) {
+      refill(local, std::max(cacheSize / 2, 1));
+    }
+    if (!local.frames.empty()) {
+      int frame = local.frames.back();
+      local.frames.pop_back();
+      freeFrames--;
+      return frame;
+    }
+  }
+  // whatever is left sits in other shards' caches
+  drainShards();
+  std::lock_guard<std::mutex> lock(globalMutex);
+  int frame = global.allocate();
+  if (frame != -1) {
+    freeFrames--;
+  }
+  return frame;
+}
+
+bool FramePool::allocate(int shard, int count, std::vector<int> &frames) {
+  if (count <= 0) {
+    return count == 0;
+  }
+  if (freeFrames < count) {
+    return false;
+  }
+  Shard &local = shardFor(shard);
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    if (attempt == 1) {
+      drainShards();
+    }
+    std::lock_guard<std::mutex> lock(local.mutex);
+    int cached = static_cast<int>(local.frames.size());
+    if (cached < count) {
+      refill(local, count - cached + cacheSize / 2);
+    }
+    if (static_cast<int>(local.frames.size()) >= count) {
+      for (int i = 0; i < count; ++i) {
+        frames.push_back(local.frames.back());
+        local.frames.pop_back();
+      }
+      freeFrames -= count;
+      return true;
+    }
+  }
+  return false;
+}
+
+void FramePool::release(int shard, int frame) {
+  Shard &local = shardFor(shard);
+  std::lock_guard<std::mutex> lock(local.mutex);
+  local.frames.push_back(frame);
+  freeFrames++;
+  if (static_cast<int>(local.frames.size()) > cacheSize) {
+    spill(local);
+  }
+}
+
+void FramePool::release(int shard, const std::vector<int> &frames) {
+  Shard &local = shardFor(shard);
+  std::lock_guard<std::mutex> lock(local.mutex);
+  local.frames.insert(local.frames.end(), frames.rbegin(), frames.rend());
+  freeFrames += static_cast<int>(frames.size());
+  if (static_cast<int>(local.frames.size()) > cacheSize) {
+    spill(local);
+  }
+}
+
+int FramePool::freeCount() const { return freeFrames; }
+
+int FramePool::totalCount() const { return frameCount; }
+
+FramePool::Shard &FramePool::shardFor(int shard) {
+  return shards[static_cast<size_t>(std::max(shard, 0)) % shards.size()];
+}
+
+// Cached frames are popped from the back, so they are stored in reverse to
+// keep handing out the lowest-numbered frames first on a fresh pool.
+void FramePool::refill(Shard &shard, int count) {
+  std::vector<int> taken;
+  {
+    std::lock_guard<std::mutex> lock(globalMutex);
+    global.allocate(std::min(count, global.freeCount()), taken);
+  }
+  shard.frames.insert(shard.frames.begin(), taken.rbegin(), taken.rend());
+}
+
+// keeps the most recently freed half of a cache, the rest goes back to the
+// global pool
+void FramePool::spill(Shard &shard) {
+  size_t spilled = shard.frames.size() - static_cast<size_t>(cacheSize / 2);
+  std::lock_guard<std::mutex> lock(globalMutex);
+  for (size_t i = 0; i < spilled; ++i) {
+    global.release(shard.frames[i]);
+  }
+  shard.frames.erase(shard.frames.begin(), shard.frames.begin() + spilled);
+}
+
+void FramePool::drainShards() {
+  for (Shard &shard : shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.frames.empty()) {
+      continue;
+    }
+    std::lock_guard<std::mutex> globalLock(globalMutex);
+    global.release(shard.frames);
+    shard.frames.clear();
+  }
+}
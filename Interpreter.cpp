@@ -0,0 +1,206 @@
+#include "headers/Interpreter.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+Program Interpreter::generateProgram(int instructionCount) {
+  Program program;
+  program.code.reserve(instructionCount + 1);
+  emitBlock(program, std::max(instructionCount, 0), 0, 1);
+  program.code.push_back({OP_HALT, 0, 0, 0, 0});
+  program.instructionCount = std::max(instructionCount, 0);
+  return program;
+}
+
+/*
+ * Emits code that executes exactly `size` instructions. A FOR loop with r
+ * repeats around a body of n instructions accounts for r * n of them;
+ * `multiplier` is how many times the block itself runs.
+ */
+void Interpreter::emitBlock(Program &program, int size, int depth,
+                            int multiplier) {
+  while (size > 0) {
+    if (depth < MAX_FOR_DEPTH && size >= 4 && rand() % 8 == 0) {
+      int repeats = 2 + rand() % 3;
+      int body = 1 + rand() % std::min(size / repeats, 8);
+
+      size_t bodyStart = program.code.size() + 1;
+      program.code.push_back(
+          {OP_FOR, 0, static_cast<uint16_t>(repeats), 0, 0});
+      emitBlock(program, body, depth + 1, multiplier * repeats);
+      program.code.push_back(
+          {OP_ENDFOR, 0, static_cast<uint16_t>(bodyStart), 0, 0});
+      size -= repeats * body;
+      continue;
+    }
+
+    Instruction instruction = randomLeaf();
+    if (instruction.opcode == OP_PRINT) {
+      program.printCount += multiplier;
+    }
+    program.code.push_back(instruction);
+    size--;
+  }
+}
+
+Instruction Interpreter::randomLeaf() {
+  uint16_t slot = rand() % MAX_VARIABLES;
+  switch (rand() % 10) {
+  case 0:
+  case 1:
+    return {OP_PRINT, static_cast<uint8_t>(rand() % 2 ? PRINT_VARIABLE : 0),
+            slot, 0, 0};
+  case 2:
+  case 3:
+    return {OP_DECLARE, 0, slot, static_cast<uint16_t>(rand() % 65536), 0};
+  case 4:
+  case 5:
+  case 6:
+  case 7: {
+    uint8_t flags = 0;
+    uint16_t b = rand() % MAX_VARIABLES;
+    uint16_t c = rand() % MAX_VARIABLES;
+    if (rand() % 2) {
+      flags |= OPERAND_B_IMMEDIATE;
+      b = rand() % 1000;
+    }
+    if (rand() % 2) {
+      flags |= OPERAND_C_IMMEDIATE;
+      c = rand() % 1000;
+    }
+    return {rand() % 2 ? OP_ADD : OP_SUBTRACT, flags, slot, b, c};
+  }
+  default:
+    return {OP_SLEEP, 0, static_cast<uint16_t>(1 + rand() % 5), 0, 0};
+  }
+}
+
+/*
+ * Threaded dispatch: each handler jumps straight to the next handler through
+ * a table of label addresses (GCC/Clang computed goto), so there is no shared
+ * dispatch branch to mispredict. Other compilers fall back to a switch loop.
+ */
+#if defined(__GNUC__)
+#define HANDLER(op) handle_##op
+#define NEXT() goto *dispatchTable[code[pc].opcode]
+#else
+#define HANDLER(op) case op
+#define NEXT() continue
+#endif
+#define RETIRE()                                                               \
+  do {                                                                         \
+    if (++executed == budget) {                                                \
+      goto done;                                                               \
+    }                                                                          \
+  } while (0)
+
+int Interpreter::execute(const Program &program, ExecutionState &state,
+                         int budget) {
+  if (program.code.empty()) {
+    state.finished = true;
+  }
+  if (state.finished || budget <= 0) {
+    return 0;
+  }
+  const Instruction *code = program.code.data();
+  uint32_t pc = state.pc;
+  uint16_t *slots = state.slots.data();
+  int executed = 0;
+
+#if defined(__GNUC__)
+  static void *dispatchTable[] = {
+      &&handle_OP_PRINT, &&handle_OP_DECLARE, &&handle_OP_ADD,
+      &&handle_OP_SUBTRACT, &&handle_OP_SLEEP, &&handle_OP_FOR,
+      &&handle_OP_ENDFOR, &&handle_OP_HALT};
+  NEXT();
+#else
+  for (;;) {
+    switch (code[pc].opcode) {
+#endif
+
+HANDLER(OP_PRINT) : {
+  const Instruction &in = code[pc++];
+  bool hasValue = in.flags & PRINT_VARIABLE;
+  state.printLog.push_back({hasValue ? slots[in.a] : uint16_t(0), hasValue});
+  RETIRE();
+  NEXT();
+}
+HANDLER(OP_DECLARE) : {
+  const Instruction &in = code[pc++];
+  slots[in.a] = in.b;
+  RETIRE();
+  NEXT();
+}
+HANDLER(OP_ADD) : {
+  const Instruction &in = code[pc++];
+  uint32_t b = in.flags & OPERAND_B_IMMEDIATE ? in.b : slots[in.b];
+  uint32_t c = in.flags & OPERAND_C_IMMEDIATE ? in.c : slots[in.c];
+  slots[in.a] = static_cast<uint16_t>(std::min<uint32_t>(b + c, 65535));
+  RETIRE();
+  NEXT();
+}
+HANDLER(OP_SUBTRACT) : {
+  const Instruction &in = code[pc++];
+  int32_t b = in.flags & OPERAND_B_IMMEDIATE ? in.b : slots[in.b];
+  int32_t c = in.flags & OPERAND_C_IMMEDIATE ? in.c : slots[in.c];
+  slots[in.a] = static_cast<uint16_t>(std::max<int32_t>(b - c, 0));
+  RETIRE();
+  NEXT();
+}
+HANDLER(OP_SLEEP) : {
+  state.sleepTicks = code[pc++].a;
+  ++executed;
+  goto done;
+}
+HANDLER(OP_FOR) : {
+  state.loops[state.loopDepth++] = {pc + 1, code[pc].a};
+  ++pc;
+  NEXT();
+}
+HANDLER(OP_ENDFOR) : {
+  ExecutionState::LoopFrame &loop = state.loops[state.loopDepth - 1];
+  if (--loop.remaining > 0) {
+    pc = loop.bodyStart;
+  } else {
+    state.loopDepth--;
+    ++pc;
+  }
+  NEXT();
+}
+HANDLER(OP_HALT) : {
+  state.finished = true;
+  goto done;
+}
+
+#if !defined(__GNUC__)
+    }
+  }
+#endif
+
+done:
+  // run the free control flow up to the next real instruction, so a program
+  // that just retired its last instruction is reported finished right away
+  while (code[pc].opcode == OP_FOR || code[pc].opcode == OP_ENDFOR) {
+    if (code[pc].opcode == OP_FOR) {
+      state.loops[state.loopDepth++] = {pc + 1, code[pc].a};
+      ++pc;
+      continue;
+    }
+    ExecutionState::LoopFrame &loop = state.loops[state.loopDepth - 1];
+    if (--loop.remaining > 0) {
+      pc = loop.bodyStart;
+    } else {
+      state.loopDepth--;
+      ++pc;
+    }
+  }
+  if (code[pc].opcode == OP_HALT) {
+    state.finished = true;
+  }
+  state.pc = pc;
+  return executed;
+}
+
+#undef HANDLER
+#undef RETIRE
+#undef NEXT
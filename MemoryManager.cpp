@@ -1,7 +1,7 @@
 #include "headers/MemoryManager.h"
 
 #include <algorithm>
-#include <filesystem>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -13,16 +13,36 @@
 
 MemoryManager::MemoryManager(int maxMemory, int frameSize,
                              int minMemoryPerProcess, int maxMemoryPerProcess,
-                             int memPerFrame)
-    : maxMemory(maxMemory), frameSize(frameSize),
-      minMemoryPerProcess(minMemoryPerProcess), memPerFrame(memPerFrame) {
-  memoryBlocks.push_back({0, maxMemory - 1, ""}); // Initial free block
-  int numFrames = maxMemory / frameSize;
-  for (int i = 1; i <= numFrames; i++) {
-
-    Frame newFrame = {nullptr, "", -1, 0};
-    processFrameMap.insert({i, newFrame});
-    freeFrameList.push_back(i);
+                             int memPerFrame,
+                             const std::string &pageReplacement,
+                             const std::string &allocationStrategy,
+                             const std::string &memoryMode,
+                             int compactionThreshold, int compactionRate,
+                             int swapSize, bool swapMmap, int cores)
+    : memoryMode(memoryMode), maxMemory(maxMemory), frameSize(frameSize),
+      minMemoryPerProcess(minMemoryPerProcess),
+      maxMemoryPerProcess(maxMemoryPerProcess), memPerFrame(memPerFrame),
+      compactionThreshold(compactionThreshold),
+      compactionRate(std::max(compactionRate, 0)),
+      pageReplacement(pageReplacement),
+      framePool(maxMemory / frameSize, cores,
+                std::clamp(maxMemory / frameSize / (4 * std::max(cores, 1)),
+                           1, 64)),
+      frameTable(maxMemory / frameSize),
+      swapSpace("backing_store.bin",
+                memoryMode == "paging" ? swapSize / frameSize : 0, frameSize,
+                swapMmap),
+      flatAllocator(memoryMode == "flat" ? maxMemory : 0, allocationStrategy),
+      buddyAllocator(memoryMode == "buddy" ? maxMemory : 0) {
+  if (memoryMode == "paging") {
+    physicalMemory.resize(static_cast<size_t>(frameTable.size()) * frameSize);
+  }
+  replacementPolicy =
+      PageReplacementPolicy::create(pageReplacement, maxMemory / frameSize);
+  if (replacementPolicy == nullptr) {
+    this->pageReplacement = "fifo";
+    replacementPolicy = PageReplacementPolicy::create("fifo",
+                                                      maxMemory / frameSize);
   }
 }
 
@@ -32,325 +52,702 @@ MemoryManager::MemoryManager(int maxMemory, int frameSize,
  * processPageReq - total pages required for the process. Formula: processSize /
  * frameSize
  */
-bool MemoryManager::pagingAllocate(Process *process, int processPageReq) {
-  // get unix timestamp
+bool MemoryManager::pagingAllocate(Process *process, int processPageReq,
+                                   int core) {
+  // frame numbers come from the core's cache without the frame table lock
+  std::vector<int> frames;
+  if (!framePool.allocate(core, processPageReq, frames)) {
+    return false;
+  }
   std::lock_guard<std::mutex> lock(frameMutex);
-  std::time_t timestamp = std::time(nullptr);
+  uint64_t loadTick = ++memoryTick;
   int processSize = process->getProcessSize();
 
-  // std::cout << "Allocating " << processPageReq << " pages for process "
-  //           << process->getProcessName() << std::endl;
+  if (static_cast<int>(process->pageTable.size()) < processPageReq) {
+    process->pageTable.resize(processPageReq);
+    process->swapSlots.resize(processPageReq, -1);
+  }
+  if (swapIo != nullptr) {
+    int swapped = static_cast<int>(
+        std::count_if(process->swapSlots.begin(),
+                      process->swapSlots.begin() + processPageReq,
+                      [](int slot) { return slot != -1; }));
+    if (swapIo->freeCapacity() < swapped) {
+      framePool.release(core, frames);
+      return false;
+    }
+  }
 
-  if (freeFrameList.empty()) {
-    return false;
+  addResident(process);
+  for (int page = 0; page < processPageReq; page++) {
+    int frame = frames[page];
+    frameTable[frame].pid = process->getPid();
+    frameTable[frame].processPage = page;
+    frameTable[frame].loadTick = loadTick;
+    frameTable[frame].lastReferenceTick = loadTick;
+    frameTable[frame].processSizeInMem =
+        std::min(frameSize, processSize - page * frameSize);
+
+    if (loadPage(process, page, frame)) {
+      process->pageTable[page].frame = frame;
+    }
+    process->residentPages++;
+    pagedIns += 1;
   }
 
-  if (processPageReq == 1) {
-    int page = freeFrameList.front();
-    freeFrameList.erase(freeFrameList.begin());
+  return true;
+}
 
-    processFrameMap[page].processSizeInMem = processSize;
-    processFrameMap[page].processName = process->getProcessName();
-    processFrameMap[page].processPage = page;
-    processFrameMap[page].timestamp = timestamp;
-    processFrameMap[page].processPtr = process;
+/*
+ * Walks the resident list from its least recently used end. Only processes
+ * on a core or with page-ins in flight are skipped, so at most about one per
+ * core is looked at before a victim turns up.
+ */
+Process *MemoryManager::getLeastRecentlyUsedProcess() {
+  std::lock_guard<std::mutex> lock(frameMutex);
+  for (Process *process = lruHead; process != nullptr;
+       process = process->residentNext) {
+    if (!process->isRunning && process->pendingPageIns == 0) {
+      return process;
+    }
+  }
+  return nullptr;
+}
 
-    // std::cout << "Allocated page " << page << " for process "
-    //           << process->getProcessName() << std::endl;
+// Moves a resident process to the most recently used end of the list.
+void MemoryManager::touchResident(Process *process) {
+  std::lock_guard<std::mutex> lock(frameMutex);
+  if (!process->onResidentList) {
+    return;
+  }
+  process->residentTick = ++memoryTick;
+  if (process == lruTail) {
+    return;
+  }
+  unlinkResident(process);
+  linkResident(process);
+}
 
-    process->pages.push_back(page);
-    pagedIns += 1;
-    return true;
+bool MemoryManager::pagingDeallocate(Process *process, bool swapOut,
+                                     int core) {
+  std::lock_guard<std::mutex> lock(frameMutex);
+  if (!swapOut) {
+    releaseSwapSlots(process);
+  }
+  if (process->residentPages == 0) {
+    return false;
+  }
+  // resident pages never hold a slot, so each needs a new one
+  if (swapOut && (swapSpace.freeSlots() < process->residentPages ||
+                  process->pendingPageIns > 0 ||
+                  (swapIo != nullptr &&
+                   swapIo->freeCapacity() < process->residentPages))) {
+    return false;
+  }
+  unpinFrames(process);
+
+  std::vector<int> freed;
+  for (int page = 0; page < static_cast<int>(process->pageTable.size());
+       page++) {
+    PageTableEntry &entry = process->pageTable[page];
+    if (entry.frame == -1) {
+      continue;
+    }
+    if (swapOut) {
+      savePage(process, page, entry.frame);
+    }
+    if (process->demandPaged) {
+      replacementPolicy->pageRemoved(entry.frame);
+    }
+    frameTable[entry.frame] = Frame();
+    freed.push_back(entry.frame);
+    entry.frame = -1;
+    pagedOuts += 1;
   }
+  framePool.release(core, freed);
+  process->residentPages = 0;
+  process->referenceLog.clear();
+  removeResident(process);
 
-  for (int i = 1; i <= processPageReq; i++) {
-    int currSize = processSize - memPerFrame;
-    int page = freeFrameList.front();
-    freeFrameList.erase(freeFrameList.begin());
+  return true;
+}
 
-    processFrameMap[page].processName = process->getProcessName();
-    processFrameMap[page].processPage = page;
-    processFrameMap[page].timestamp = timestamp;
-    processFrameMap[page].processPtr = process;
-    if (currSize < 0) {
-      processFrameMap[page].processSizeInMem = processSize;
+/*
+ * Sizes the page table of a demand-paged process. Nothing is loaded; every
+ * page comes in on its first fault.
+ */
+void MemoryManager::preparePageTable(Process *process) {
+  std::lock_guard<std::mutex> lock(frameMutex);
+  if (process->demandPaged) {
+    return;
+  }
+  int pageCount = std::max(
+      (process->getProcessSize() + frameSize - 1) / frameSize, 1);
+  process->pageTable.resize(pageCount);
+  process->swapSlots.resize(pageCount, -1);
+  process->pageSize = frameSize;
+  process->demandPaged = true;
+}
+
+/*
+ * Brings one page of a demand-paged process into memory, evicting another
+ * page when no frame is free. Returns false if no frame could be freed.
+ */
+bool MemoryManager::pageIn(Process *process, int page, int core) {
+  // a free frame comes from the core's cache before the frame table is locked
+  int frame = framePool.allocate(core);
+  std::lock_guard<std::mutex> lock(frameMutex);
+  // the policy sees the faulting process' recent references first
+  recordReferencesLocked(process);
+  PageTableEntry &entry = process->pageTable[page];
+  // room for the victim's page-out and this page-in
+  if (entry.frame != -1 || (swapIo != nullptr && swapIo->freeCapacity() < 2)) {
+    if (frame != -1) {
+      framePool.release(core, frame);
+    }
+    return entry.frame != -1;
+  }
+  uint64_t pageKey = (static_cast<uint64_t>(process->getPid()) << 32) | page;
+  bool loaded;
+  if (frame == -1) {
+    // The victim's page has to go somewhere. With swap full it takes over the
+    // slot this page is read from; a page that has no slot cannot come in.
+    bool exchange = swapSpace.freeSlots() == 0;
+    if (exchange && process->swapSlots[page] == -1) {
+      return false;
+    }
+    int victim = replacementPolicy->selectVictim(pageKey, [&](int candidate) {
+      return isPinned(candidate, process);
+    });
+    if (victim == -1) {
+      return false;
+    }
+    // the victim's frame is reused directly, never going back to the pool
+    frame = victim;
+    if (exchange) {
+      loaded = exchangePage(process, page, frame);
     } else {
-      processFrameMap[page].processSizeInMem = currSize;
+      evictFrame(frame);
+      loaded = loadPage(process, page, frame);
     }
+  } else {
+    loaded = loadPage(process, page, frame);
+  }
+  addResident(process);
+  replacementPolicy->pageLoaded(frame, pageKey);
+  frameTable[frame].pid = process->getPid();
+  frameTable[frame].processPage = page;
+  frameTable[frame].loadTick = ++memoryTick;
+  frameTable[frame].lastReferenceTick = memoryTick;
+  frameTable[frame].processSizeInMem =
+      std::min(frameSize, process->getProcessSize() - page * frameSize);
+  process->residentPages++;
+  pageFaults += 1;
+  pagedIns += 1;
+  if (loaded) {
+    entry.frame = frame;
+    pinTouchedPages(process);
+  }
+  return true;
+}
 
-    /*std::cout << "Mem size for: " << processFrameMap[page].processSizeInMem*/
-    /*          << " for process " << process->getProcessName() << std::endl;*/
-
-    process->pages.push_back(page);
-    pagedIns += 1;
+// Pin what the faulting instruction needs until the process leaves its core,
+// so faults on other cores cannot take it away before the retry.
+void MemoryManager::pinTouchedPages(Process *process) {
+  unpinFrames(process);
+  for (int i = 0; i < 2; ++i) {
+    int touched = process->touchedPages[i];
+    int pinned = touched == -1 ? -1 : process->pageTable[touched].frame.load();
+    if (pinned != -1) {
+      frameTable[pinned].pinned = true;
+    }
+    process->pinnedFrames[i] = pinned;
   }
+}
 
-  return true;
+/*
+ * Moves swap I/O to its own thread. Page-ins then complete asynchronously:
+ * the frame stays pinned and out of the page table until the read is done,
+ * and onWake is called once a process has no page-ins left.
+ */
+void MemoryManager::startSwapIo(std::function<void(Process *)> onWake) {
+  onSwapWake = std::move(onWake);
+  int capacity = std::max(2 * static_cast<int>(frameTable.size()) + 2, 64);
+  swapIo = new SwapIo(swapSpace, capacity, frameSize,
+                      [this](const SwapRequest &request) {
+                        completePageIn(request);
+                      });
+  swapIo->start();
 }
 
-Process *MemoryManager::getOldestProcessInFrameMap() {
-  std::lock_guard<std::mutex> lock(frameMutex);
-  std::time_t oldestTimestamp = std::time(nullptr);
-  Process *oldestProcess = nullptr;
-  // traverse through the processFrameMap to find the oldest process
-  for (const auto &pair : processFrameMap) {
-    if (pair.second.timestamp < oldestTimestamp && !pair.second.processPtr->isRunning) {
-      oldestTimestamp = pair.second.timestamp;
-      oldestProcess = pair.second.processPtr;
+void MemoryManager::completePageIn(const SwapRequest &request) {
+  Process *process = request.process;
+  bool lastPage;
+  {
+    std::lock_guard<std::mutex> lock(frameMutex);
+    // an exchanged slot already belongs to the evicted page
+    if (request.kind == SwapRequest::PAGE_IN) {
+      swapSpace.releaseSlot(request.slot);
+      process->swapSlots[request.page] = -1;
+    }
+    frameTable[request.frame].pinned = false;
+    process->pageTable[request.page].frame = request.frame;
+    if (process->demandPaged) {
+      pinTouchedPages(process);
     }
+    lastPage = --process->pendingPageIns == 0;
+  }
+  if (lastPage) {
+    onSwapWake(process);
   }
-  return oldestProcess;
 }
 
-std::vector<int>
-MemoryManager::findProcessInMap(const std::string &processName) {
-  std::lock_guard<std::mutex> lock(frameMutex);
-  std::vector<int> pages;
-  for (const auto &pair : processFrameMap) {
-    if (pair.second.processName == processName) {
-      pages.push_back(pair.first);
+void MemoryManager::unpinFrames(Process *process) {
+  for (int &frame : process->pinnedFrames) {
+    if (frame != -1) {
+      frameTable[frame].pinned = false;
+      frame = -1;
     }
   }
-  return pages;
 }
 
-bool MemoryManager::pagingDeallocate(Process *process) {
-  std::vector<int> pages = findProcessInMap(process->getProcessName());
+// Neither pinned frames nor the pages the faulting instruction needs may be
+// evicted.
+bool MemoryManager::isPinned(int frame, const Process *faulting) const {
+  const Frame &candidate = frameTable[frame];
+  if (candidate.pinned) {
+    return true;
+  }
+  return candidate.pid == faulting->getPid() &&
+         (candidate.processPage == faulting->touchedPages[0] ||
+          candidate.processPage == faulting->touchedPages[1]);
+}
 
-  if (pages.empty()) {
-    return false;
+/*
+ * Hands the references a demand-paged process logged while running to the
+ * replacement policy, in order, stamping each frame with the memory tick.
+ * releasePins is set when the process is about to leave its core.
+ */
+void MemoryManager::recordReferences(Process *process, bool releasePins) {
+  std::lock_guard<std::mutex> lock(frameMutex);
+  recordReferencesLocked(process);
+  if (releasePins) {
+    unpinFrames(process);
   }
+}
 
-  for (const int page : pages) {
-    processFrameMap[page].processName = "";
-    processFrameMap[page].processPage = -1;
-    processFrameMap[page].timestamp = 0;
-    processFrameMap[page].processPtr = nullptr;
+void MemoryManager::recordReferencesLocked(Process *process) {
+  for (int page : process->referenceLog) {
+    int frame = process->pageTable[page].frame;
+    if (frame != -1) {
+      frameTable[frame].lastReferenceTick = ++memoryTick;
+      replacementPolicy->pageReferenced(frame);
+    }
+  }
+  process->referenceLog.clear();
+  pageReferences += process->pendingReferences;
+  process->pendingReferences = 0;
+}
 
-    freeFrameList.push_back(page);
-    auto newEnd =
-        std::remove(process->pages.begin(), process->pages.end(), page);
+void MemoryManager::evictFrame(int frame) {
+  Frame &victim = frameTable[frame];
+  Process *owner = processTable[victim.pid];
+  savePage(owner, victim.processPage, frame);
+  owner->pageTable[victim.processPage].frame = -1;
+  if (--owner->residentPages == 0) {
+    removeResident(owner);
+  }
+  victim = Frame();
+  pagedOuts += 1;
+}
 
-    process->pages.erase(newEnd, process->pages.end());
-    pagedOuts += 1;
+/*
+ * Evicts the page in frame into the slot that page of process is read from,
+ * for when swap has no free slot left. Resident pages never hold a slot, so
+ * the victim always needs one and the incoming page always gives one up.
+ * Returns false if the exchange was handed to the swap I/O thread.
+ */
+bool MemoryManager::exchangePage(Process *process, int page, int frame) {
+  Frame &victim = frameTable[frame];
+  Process *owner = processTable[victim.pid];
+  int &slot = process->swapSlots[page];
+  char *bytes = frameBytes(frame);
+  bool loaded = swapIo == nullptr;
+  if (loaded) {
+    exchangeBuffer.resize(frameSize);
+    swapSpace.read(slot, exchangeBuffer.data());
+    swapSpace.write(slot, bytes);
+    std::memcpy(bytes, exchangeBuffer.data(), frameSize);
+  } else {
+    process->pendingPageIns++;
+    swapIo->exchange(slot, bytes, process, page, frame);
   }
+  swapReads++;
+  swapWrites++;
+  owner->swapSlots[victim.processPage] = slot;
+  owner->pageTable[victim.processPage].frame = -1;
+  if (--owner->residentPages == 0) {
+    removeResident(owner);
+  }
+  victim = Frame();
+  victim.pinned = !loaded;
+  pagedOuts += 1;
+  slot = -1;
+  return loaded;
+}
 
-  return true;
+void MemoryManager::addResident(Process *process) {
+  if (process->onResidentList) {
+    return;
+  }
+  int pid = process->getPid();
+  if (pid >= static_cast<int>(processTable.size())) {
+    processTable.resize(pid + 1, nullptr);
+  }
+  processTable[pid] = process;
+  process->residentTick = ++memoryTick;
+  process->onResidentList = true;
+  residentProcessCount++;
+  linkResident(process);
 }
 
-void MemoryManager::writeBackingStore(Process *process) {
-  std::string fileName = "backing_store.txt";
-  std::ofstream file;
+void MemoryManager::removeResident(Process *process) {
+  if (!process->onResidentList) {
+    return;
+  }
+  unlinkResident(process);
+  processTable[process->getPid()] = nullptr;
+  process->onResidentList = false;
+  residentProcessCount--;
+}
 
-  // Open the file in append mode
-  file.open(fileName, std::ios::out | std::ios::app);
+void MemoryManager::linkResident(Process *process) {
+  process->residentPrev = lruTail;
+  process->residentNext = nullptr;
+  if (lruTail != nullptr) {
+    lruTail->residentNext = process;
+  } else {
+    lruHead = process;
+  }
+  lruTail = process;
+}
 
-  if (!file) {
-    std::cerr << "Could not open file!" << std::endl;
+void MemoryManager::unlinkResident(Process *process) {
+  if (process->residentPrev != nullptr) {
+    process->residentPrev->residentNext = process->residentNext;
+  } else {
+    lruHead = process->residentNext;
+  }
+  if (process->residentNext != nullptr) {
+    process->residentNext->residentPrev = process->residentPrev;
   } else {
-    file << "\n"; // Optional: add a newline before writing
-    file << process->getProcessName() << "\t";
-    file << process->getInstructionsDone() << std::endl;
+    lruTail = process->residentPrev;
   }
+  process->residentPrev = nullptr;
+  process->residentNext = nullptr;
+}
 
-  file.close();
+char *MemoryManager::frameBytes(int frame) {
+  return physicalMemory.data() + static_cast<size_t>(frame) * frameSize;
 }
 
-bool MemoryManager::isProcessinPagingMemory(Process *process) {
-  if (process->pages.size() == 0) {
-    return false;
+/*
+ * Fills a frame with a page of the process. A page that was swapped out is
+ * read back from its slot, which is then free again; a page seen for the
+ * first time comes from the process image, its bytecode followed by zeroes.
+ * Returns false if the read was handed to the swap I/O thread instead.
+ */
+bool MemoryManager::loadPage(Process *process, int page, int frame) {
+  char *bytes = frameBytes(frame);
+  int &slot = process->swapSlots[page];
+  if (slot != -1) {
+    swapReads++;
+    if (swapIo != nullptr) {
+      frameTable[frame].pinned = true;
+      process->pendingPageIns++;
+      swapIo->pageIn(slot, bytes, process, page, frame);
+      return false;
+    }
+    swapSpace.read(slot, bytes);
+    swapSpace.releaseSlot(slot);
+    slot = -1;
+    return true;
   }
+  const std::vector<Instruction> &code = process->getProgram().code;
+  size_t imageSize = code.size() * sizeof(Instruction);
+  size_t offset = static_cast<size_t>(page) * frameSize;
+  size_t copied = offset < imageSize
+                      ? std::min(imageSize - offset, static_cast<size_t>(frameSize))
+                      : 0;
+  std::memcpy(bytes, reinterpret_cast<const char *>(code.data()) + offset,
+              copied);
+  std::memset(bytes + copied, 0, frameSize - copied);
   return true;
 }
 
+// Callers make sure a slot is free before they evict.
+void MemoryManager::savePage(Process *process, int page, int frame) {
+  int &slot = process->swapSlots[page];
+  if (slot == -1) {
+    slot = swapSpace.allocateSlot();
+  }
+  if (swapIo != nullptr) {
+    swapIo->pageOut(slot, frameBytes(frame));
+  } else {
+    swapSpace.write(slot, frameBytes(frame));
+  }
+  swapWrites++;
+}
+
+void MemoryManager::releaseSwapSlots(Process *process) {
+  for (int &slot : process->swapSlots) {
+    if (slot != -1) {
+      swapSpace.releaseSlot(slot);
+      slot = -1;
+    }
+  }
+}
+
+bool MemoryManager::isProcessinPagingMemory(Process *process) {
+  return process->residentPages > 0;
+}
+
 bool MemoryManager::allocateMemory(const std::string &processName,
                                    int processSize) {
-  int index = findFirstFit(processSize);
-  if (index == -1) {
+  std::lock_guard<std::mutex> lock(frameMutex);
+  int start = memoryMode == "buddy" ? buddyAllocator.allocate(processSize)
+                                    : flatAllocator.allocate(processSize);
+  if (start == -1 && memoryMode == "flat" &&
+      flatAllocator.freeBytes() >= processSize) {
+    // enough memory is free, just not in one piece
+    waitingOnCompaction.insert(processName);
+    compactionActive = true;
+    if (compactionRate == 0) {
+      compactLocked();
+      start = flatAllocator.allocate(processSize);
+    }
+  }
+  if (start == -1) {
+    failedAllocations++;
     return false;
   }
-
-  MemoryBlock &block = memoryBlocks[index];
-  if (block.end - block.start + 1 == processSize) {
-    block.processName = processName;
-  } else {
-    MemoryBlock newBlock = {block.start, block.start + processSize - 1,
-                            processName};
-    block.start += processSize;
-    memoryBlocks.insert(memoryBlocks.begin() + index, newBlock);
+  if (waitingOnCompaction.erase(processName) != 0) {
+    rescuedAllocations++;
   }
+  blockStart[processName] = start;
+  blockOwner[start] = processName;
+  updateAccounting();
   return true;
 }
 
 void MemoryManager::deallocateMemory(const std::string &processName) {
-  for (auto it = memoryBlocks.begin(); it != memoryBlocks.end(); ++it) {
-    if (it->processName == processName) {
-      it->processName = "";
-      if (it != memoryBlocks.begin() && (it - 1)->processName.empty()) {
-        it->start = (it - 1)->start;
-        memoryBlocks.erase(it - 1);
-        --it;
-      }
-      if (it != memoryBlocks.end() - 1 && (it + 1)->processName.empty()) {
-        it->end = (it + 1)->end;
-        memoryBlocks.erase(it + 1);
+  std::lock_guard<std::mutex> lock(frameMutex);
+  auto it = blockStart.find(processName);
+  if (it == blockStart.end()) {
+    return;
+  }
+  if (memoryMode == "buddy") {
+    buddyAllocator.release(it->second);
+  } else {
+    flatAllocator.release(it->second);
+    if (compactionThreshold > 0 &&
+        flatAllocator.fragmentationPercent() >= compactionThreshold) {
+      compactionActive = true;
+      if (compactionRate == 0) {
+        compactLocked();
       }
-      break;
     }
   }
+  blockOwner.erase(it->second);
+  blockStart.erase(it);
+  updateAccounting();
 }
 
-bool MemoryManager::isProcessInMemory(const std::string &processName) {
-  for (const auto &block : memoryBlocks) {
-    if (block.processName == processName) {
-      return true;
-    }
+void MemoryManager::updateAccounting() {
+  if (memoryMode == "buddy") {
+    usedMemory = buddyAllocator.usedBytes();
+    externalFragmentation = buddyAllocator.externalFragmentation();
+    internalFragmentation = buddyAllocator.internalFragmentation();
+    residentProcessCount = buddyAllocator.allocatedBlockCount();
+  } else {
+    usedMemory = flatAllocator.usedBytes();
+    externalFragmentation = flatAllocator.externalFragmentation();
+    residentProcessCount = flatAllocator.allocatedBlockCount();
   }
-  return false;
-}
-
-void MemoryManager::generateReport(const std::string &filename) {
-  std::string folderPath =
-      "./memory_stamps"; // Relative path, or use "/memory_stamps" for absolute
-  // path
-  if (!std::filesystem::exists(folderPath)) {
-    std::filesystem::create_directory(folderPath);
-  }
-
-  std::string filePath = folderPath + "/" + filename;
-  std::ofstream reportFile(filePath);
-  if (!reportFile.is_open()) {
-    throw std::runtime_error("Could not open report file");
-  }
-
-  time_t now = std::time(nullptr);
-  reportFile << "Timestamp: "
-             << std::put_time(std::localtime(&now), "%Y-%m-%d %H:%M:%S")
-             << std::endl;
-  reportFile << "Number of processes in memory: "
-             << std::count_if(memoryBlocks.begin(), memoryBlocks.end(),
-                              [](const MemoryBlock &block) {
-                                return !block.processName.empty();
-                              })
-             << std::endl;
-  reportFile << "Total external fragmentation: "
-             << calculateExternalFragmentation() << " KB" << std::endl;
-  reportFile << "Memory Layout: " << std::endl;
-  reportFile << "----start---- = 0" << std::endl;
-  for (const auto &block : memoryBlocks) {
-    if (block.processName.empty()) {
-      // reportFile << "[Free: " << block.start << "-" << block.end << "]";
-      reportFile << "\n";
-    } else {
-      reportFile << block.start << std::endl;
-      reportFile << block.processName << std::endl;
-      reportFile << block.end << "\n" << std::endl;
-    }
+}
+
+bool MemoryManager::compactStep(uint64_t ticks) {
+  std::lock_guard<std::mutex> lock(frameMutex);
+  if (!compactionActive) {
+    return false;
   }
-  reportFile << "----end---- = " << maxMemory << std::endl;
-  reportFile << "\n\n";
-  reportFile.close();
+  compactionCredit += compactionRate * static_cast<int>(ticks);
+  compactLocked();
+  updateAccounting();
+  return !compactionActive;
 }
 
-int MemoryManager::findFirstFit(int processSize) {
-  for (size_t i = 0; i < memoryBlocks.size(); ++i) {
-    if (memoryBlocks[i].processName.empty() &&
-        memoryBlocks[i].end - memoryBlocks[i].start + 1 >= processSize) {
-      return i;
+/*
+ * Slides blocks down until memory is compact or the next block is larger than
+ * the bytes earned so far. Credit carries over between steps, so a block
+ * larger than compactionRate still moves, just a few steps later.
+ */
+void MemoryManager::compactLocked() {
+  int size;
+  while ((size = flatAllocator.nextSlideSize()) != 0) {
+    if (compactionRate != 0 && size > compactionCredit) {
+      return;
     }
+    int from;
+    int to;
+    flatAllocator.slideDown(from, to);
+    if (compactionRate != 0) {
+      compactionCredit -= size;
+    }
+    std::string owner = blockOwner[from];
+    blockOwner.erase(from);
+    blockOwner[to] = owner;
+    blockStart[owner] = to;
+    compactedBytes += size;
+    compactionMoves++;
   }
-  return -1;
+  compactionActive = false;
+  compactionCredit = 0;
+  compactionPasses++;
+}
+
+bool MemoryManager::isProcessInMemory(const std::string &processName) {
+  std::lock_guard<std::mutex> lock(frameMutex);
+  return blockStart.count(processName) != 0;
+}
+
+void MemoryManager::captureStamp(MemoryStamp &stamp) {
+  std::lock_guard<std::mutex> lock(frameMutex);
+  // every stamp is one sample of fragmentation over time
+  int fragmentation = externalFragmentation;
+  fragmentationSamples++;
+  fragmentationTotal += fragmentation;
+  if (fragmentation > fragmentationPeak) {
+    fragmentationPeak = fragmentation;
+  }
+  fillStamp(stamp);
 }
 
 void MemoryManager::VisualizeMemory() {
-  time_t now = std::time(nullptr);
-  std::cout << "Timestamp: "
-            << std::put_time(std::localtime(&now), "%Y-%m-%d %H:%M:%S")
-            << std::endl;
-  std::cout << "Number of processes in memory: "
-            << std::count_if(memoryBlocks.begin(), memoryBlocks.end(),
-                             [](const MemoryBlock &block) {
-                               return !block.processName.empty();
-                             })
-            << std::endl;
-  std::cout << "Total external fragmentation: "
-            << calculateExternalFragmentation() << " KB" << std::endl;
-  std::cout << "Memory Layout: " << std::endl;
-  std::cout << "----start---- = 0" << std::endl;
-  for (const auto &block : memoryBlocks) {
-    if (block.processName.empty()) {
-      // std::cout << "[Free: " << block.start << "-" << block.end << "]";
-      std::cout << "\n";
-    } else {
-      std::cout << block.start << std::endl;
-      std::cout << block.processName << std::endl;
-      std::cout << block.end << "\n" << std::endl;
-    }
+  MemoryStamp stamp;
+  {
+    std::lock_guard<std::mutex> lock(frameMutex);
+    fillStamp(stamp);
   }
-  std::cout << "----end---- = " << maxMemory << std::endl;
+  writeStampLayout(stamp, std::cout);
   std::cout << std::endl;
 }
 
-int MemoryManager::calculateExternalFragmentation() {
-  int fragmentation = 0;
-  for (const auto &block : memoryBlocks) {
-    if (block.processName.empty()) {
-      fragmentation += block.end - block.start + 1;
+// Copies the layout into stamp, reusing its block list. The owners' names
+// mostly fit in the strings' small buffers, so this rarely allocates.
+void MemoryManager::fillStamp(MemoryStamp &stamp) {
+  stamp.time = std::time(nullptr);
+  stamp.maxMemory = maxMemory;
+  stamp.buddy = memoryMode == "buddy";
+  size_t count = 0;
+  auto addBlock = [&](int start, int size, int requested) {
+    if (count == stamp.blocks.size()) {
+      stamp.blocks.emplace_back();
+    }
+    MemoryStamp::Block &block = stamp.blocks[count++];
+    block.start = start;
+    block.size = size;
+    block.requested = requested;
+    block.owner.clear();
+    auto owner = blockOwner.find(start);
+    if (requested != 0 && owner != blockOwner.end()) {
+      block.owner = owner->second;
+    }
+  };
+  if (stamp.buddy) {
+    stamp.strategy.clear();
+    stamp.processCount = buddyAllocator.allocatedBlockCount();
+    stamp.externalFragmentation = buddyAllocator.externalFragmentation();
+    stamp.internalFragmentation = buddyAllocator.internalFragmentation();
+    stamp.largestFreeBlock = buddyAllocator.largestFreeBlock();
+    for (const BuddyAllocator::Block &block : buddyAllocator.blocks()) {
+      addBlock(block.start, block.size, block.requested);
+    }
+  } else {
+    stamp.strategy = flatAllocator.getStrategy();
+    stamp.processCount = flatAllocator.allocatedBlockCount();
+    stamp.externalFragmentation = flatAllocator.externalFragmentation();
+    stamp.internalFragmentation = 0;
+    stamp.largestFreeBlock = flatAllocator.largestFreeBlock();
+    for (const FlatAllocator::Block &block : flatAllocator.blocks()) {
+      addBlock(block.start, block.size, block.free ? 0 : block.size);
     }
   }
-  return fragmentation;
+  stamp.blocks.resize(count);
+}
+
+// free memory outside the largest free block, the same measure the
+// compaction threshold uses
+int MemoryManager::calculateExternalFragmentation() {
+  return externalFragmentation;
+}
+
+int MemoryManager::getInternalFragmentation() { return internalFragmentation; }
+
+int MemoryManager::getResidentProcessCount() const {
+  return residentProcessCount;
+}
+
+double MemoryManager::getAverageFragmentation() {
+  uint64_t samples = fragmentationSamples;
+  return samples == 0 ? 0.0
+                      : static_cast<double>(fragmentationTotal) / samples;
 }
 
 std::string MemoryManager::getProcessMemoryBlocks() {
+  std::lock_guard<std::mutex> lock(frameMutex);
   std::ostringstream report;
-  for (const auto &frame : processFrameMap) {
-    if (!(frame.second.processPtr == nullptr)) {
-      report << frame.second.processName << " " << frame.second.processSizeInMem
-             << "Mib\n";
+  for (const Process *process = lruHead; process != nullptr;
+       process = process->residentNext) {
+    report << process->getProcessName() << " "
+           << std::min(process->residentPages * frameSize,
+                       process->getProcessSize())
+           << "Mib";
+    if (process->demandPaged) {
+      report << " (" << process->pageFaults << " faults, " << std::fixed
+             << std::setprecision(2)
+             << (process->memoryReferences == 0
+                     ? 0.0
+                     : 100.0 * process->pageFaults / process->memoryReferences)
+             << "%)";
     }
+    report << "\n";
   }
   return report.str();
 }
 
 int MemoryManager::getMemoryUsage(const std::string &memoryType) {
-  std::lock_guard<std::mutex> lock(frameMutex);
   int totalMemory = 0;
 
-  if (memoryType == "flat") {
-    for (const auto &block : memoryBlocks) {
-      if (!block.processName.empty()) {
-        totalMemory += block.end - block.start + 1;
-      }
-    }
+  if (memoryType == "flat" || memoryType == "buddy") {
+    totalMemory = usedMemory;
   } else {
-    for (const auto &frame : processFrameMap) {
-      if (frame.second.processPtr != nullptr) {
-        totalMemory += memPerFrame;
-      }
-    }
+    totalMemory = (framePool.totalCount() - framePool.freeCount()) *
+                  memPerFrame;
   }
 
   return totalMemory;
 }
 
 double MemoryManager::getMemoryUtil(const std::string &memoryType) {
-  std::lock_guard<std::mutex> lock(frameMutex);
-  std::unordered_map<int, Frame> tempProcessFrameMap = processFrameMap;
   double totalMemoryUtil;
   int totalMemory = 0;
 
-  if (memoryType == "flat") {
-    for (const auto &block : memoryBlocks) {
-      if (!block.processName.empty()) {
-        totalMemory += frameSize;
-      }
-    }
+  if (memoryType == "flat" || memoryType == "buddy") {
+    totalMemory = usedMemory;
   } else {
-    for (const auto &frame : tempProcessFrameMap) {
-      if (!(frame.second.processPtr == nullptr)) {
-        totalMemory += frameSize;
-      }
-    }
+    totalMemory = (framePool.totalCount() - framePool.freeCount()) *
+                  frameSize;
   }
 
   totalMemoryUtil = (static_cast<double>(totalMemory) / maxMemory) * 100;
@@ -358,52 +755,40 @@ double MemoryManager::getMemoryUtil(const std::string &memoryType) {
 }
 
 int MemoryManager::getFreeMemory(const std::string &memoryType) {
-  std::lock_guard<std::mutex> lock(frameMutex);
   int freeMemory = 0;
-  std::unordered_map<int, Frame> tempProcessFrameMap = processFrameMap;
 
-  if (memoryType == "flat") {
-    for (const auto &block : memoryBlocks) {
-      if (block.processName.empty()) {
-        freeMemory += frameSize;
-      }
-    }
+  if (memoryType == "flat" || memoryType == "buddy") {
+    freeMemory = maxMemory - usedMemory;
   } else {
-    for (const auto &frame : tempProcessFrameMap) {
-      if (frame.second.processPtr == nullptr) {
-        freeMemory += frameSize;
-      }
-    }
+    freeMemory = framePool.freeCount() * frameSize;
   }
 
   return freeMemory;
 }
 
 void MemoryManager::visualizeFrames() {
+  std::lock_guard<std::mutex> lock(frameMutex);
   std::cout << "+---------+----------------+----------------+------------------"
                "---+--------------+"
             << std::endl;
-  std::cout << "| Frame # | Process Name   | Process Page   | Timestamp        "
+  std::cout << "| Frame # | Process Name   | Process Page   | Load tick        "
                "   | Process Size |"
             << std::endl;
   std::cout << "+---------+----------------+----------------+------------------"
                "---+--------------+"
             << std::endl;
 
-  for (const auto &pair : processFrameMap) {
-    const Frame &frame = pair.second;
-    std::cout << "| " << std::setw(7) << pair.first << " | " << std::setw(14)
-              << (frame.processName.empty() ? "Free" : frame.processName)
+  for (size_t i = 0; i < frameTable.size(); ++i) {
+    const Frame &frame = frameTable[i];
+    bool isFree = frame.pid == -1;
+    std::cout << "| " << std::setw(7) << i << " | " << std::setw(14)
+              << (isFree ? "Free" : processTable[frame.pid]->getProcessName())
               << " | " << std::setw(14)
-              << (frame.processPage == -1 ? "N/A"
-                                          : std::to_string(frame.processPage))
+              << (isFree ? "N/A" : std::to_string(frame.processPage))
               << " | " << std::setw(19)
-              << (frame.timestamp == 0 ? "N/A"
-                                       : std::to_string(frame.timestamp))
+              << (isFree ? "N/A" : std::to_string(frame.loadTick))
               << " | " << std::setw(12)
-              << (frame.processPtr == nullptr
-                      ? "N/A"
-                      : std::to_string(frame.processSizeInMem))
+              << (isFree ? "N/A" : std::to_string(frame.processSizeInMem))
               << " |" << std::endl;
   }
 
@@ -414,12 +799,6 @@ void MemoryManager::visualizeFrames() {
 
 }
 
-int MemoryManager::getFramesOccupiedByProcess(const std::string &processName) {
-  int framesOccupied = 0;
-  for (const auto &frame : processFrameMap) {
-    if (frame.second.processName == processName) {
-      framesOccupied++;
-    }
-  }
-  return framesOccupied;
-}
\ No newline at end of file
+int MemoryManager::getFramesOccupiedByProcess(const Process *process) const {
+  return process->residentPages;
+}
@@ -0,0 +1,210 @@
+#include "headers/MemoryStamp.h"
+
+#include <ctime>
+#include <iomanip>
+#include <istream>
+#include <ostream>
+
+const std::string StampEncoder::HEADER = "CSOPESY-STAMPS 1\n";
+
+namespace {
+void putVarint(std::string &out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+void putSigned(std::string &out, int64_t value) {
+  putVarint(out, (static_cast<uint64_t>(value) << 1) ^
+                     static_cast<uint64_t>(value >> 63));
+}
+
+bool getVarint(std::istream &in, uint64_t &value) {
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    int byte = in.get();
+    if (byte == std::char_traits<char>::eof()) {
+      return false;
+    }
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool getSigned(std::istream &in, int64_t &value) {
+  uint64_t raw;
+  if (!getVarint(in, raw)) {
+    return false;
+  }
+  value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+  return true;
+}
+
+int nextStart(const std::vector<MemoryStamp::Block> &blocks) {
+  return blocks.empty() ? 0 : blocks.back().start + blocks.back().size;
+}
+} // namespace
+
+void writeStampLayout(const MemoryStamp &stamp, std::ostream &out) {
+  time_t time = static_cast<time_t>(stamp.time);
+  out << "Timestamp: "
+      << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S")
+      << std::endl;
+  out << "Number of processes in memory: " << stamp.processCount << std::endl;
+  out << "Total external fragmentation: " << stamp.externalFragmentation
+      << " KB" << std::endl;
+  if (stamp.buddy) {
+    out << "Total internal fragmentation: " << stamp.internalFragmentation
+        << " KB" << std::endl;
+  }
+  out << "Largest free block: " << stamp.largestFreeBlock << " KB ("
+      << (stamp.buddy ? "buddy" : stamp.strategy) << ")" << std::endl;
+  out << "Memory Layout: " << std::endl;
+  out << "----start---- = 0" << std::endl;
+  for (const MemoryStamp::Block &block : stamp.blocks) {
+    if (block.requested == 0) {
+      out << "\n";
+      continue;
+    }
+    out << block.start << std::endl;
+    out << block.owner;
+    if (stamp.buddy) {
+      // buddy blocks are listed at their rounded size
+      out << " (" << block.requested << " of " << block.size << " KB)";
+    }
+    out << std::endl;
+    out << block.start + block.size - 1 << "\n" << std::endl;
+  }
+  out << "----end---- = " << stamp.maxMemory << std::endl;
+}
+
+void StampEncoder::encode(const MemoryStamp &stamp, std::string &out) {
+  std::vector<const std::string *> added;
+  int strategyId = nameId(stamp.strategy, added);
+  std::vector<int> owners;
+  size_t keep = 0;
+  while (keep < stamp.blocks.size() && keep < previous.blocks.size() &&
+         stamp.blocks[keep] == previous.blocks[keep]) {
+    keep++;
+  }
+  for (size_t i = keep; i < stamp.blocks.size(); ++i) {
+    const MemoryStamp::Block &block = stamp.blocks[i];
+    owners.push_back(block.requested == 0 ? 0
+                                          : nameId(block.owner, added) + 1);
+  }
+
+  putVarint(out, added.size());
+  for (const std::string *name : added) {
+    putVarint(out, name->size());
+    out += *name;
+  }
+  putSigned(out, static_cast<int64_t>(stamp.cycle - previous.cycle));
+  putSigned(out, stamp.time - previous.time);
+  putVarint(out, stamp.buddy ? 1 : 0);
+  putVarint(out, strategyId);
+  putSigned(out, stamp.maxMemory - previous.maxMemory);
+  putSigned(out, stamp.processCount - previous.processCount);
+  putSigned(out, stamp.externalFragmentation - previous.externalFragmentation);
+  putSigned(out, stamp.internalFragmentation - previous.internalFragmentation);
+  putSigned(out, stamp.largestFreeBlock - previous.largestFreeBlock);
+
+  putVarint(out, keep);
+  putVarint(out, stamp.blocks.size() - keep);
+  int start = 0;
+  if (keep != 0) {
+    start = stamp.blocks[keep - 1].start + stamp.blocks[keep - 1].size;
+  }
+  for (size_t i = keep; i < stamp.blocks.size(); ++i) {
+    const MemoryStamp::Block &block = stamp.blocks[i];
+    putSigned(out, block.start - start);
+    putVarint(out, block.size);
+    putVarint(out, block.requested);
+    putVarint(out, owners[i - keep]);
+    start = block.start + block.size;
+  }
+  previous = stamp;
+}
+
+int StampEncoder::nameId(const std::string &name,
+                         std::vector<const std::string *> &added) {
+  auto [it, inserted] =
+      nameIds.emplace(name, static_cast<int>(nameIds.size()));
+  if (inserted) {
+    added.push_back(&it->first);
+  }
+  return it->second;
+}
+
+bool StampDecoder::readHeader(std::istream &in) {
+  std::string header(StampEncoder::HEADER.size(), '\0');
+  in.read(header.data(), static_cast<std::streamsize>(header.size()));
+  return in && header == StampEncoder::HEADER;
+}
+
+bool StampDecoder::decode(std::istream &in, MemoryStamp &stamp) {
+  uint64_t count;
+  if (!getVarint(in, count)) {
+    return false;
+  }
+  for (uint64_t i = 0; i < count; ++i) {
+    uint64_t length;
+    if (!getVarint(in, length)) {
+      return false;
+    }
+    std::string name(length, '\0');
+    in.read(name.data(), static_cast<std::streamsize>(length));
+    if (!in) {
+      return false;
+    }
+    names.push_back(std::move(name));
+  }
+
+  int64_t cycle, time, maxMemory, processCount, external, internal, largest;
+  uint64_t buddy, strategyId, keep;
+  if (!getSigned(in, cycle) || !getSigned(in, time) ||
+      !getVarint(in, buddy) || !getVarint(in, strategyId) ||
+      !getSigned(in, maxMemory) || !getSigned(in, processCount) ||
+      !getSigned(in, external) || !getSigned(in, internal) ||
+      !getSigned(in, largest) || !getVarint(in, keep) ||
+      !getVarint(in, count) || strategyId >= names.size() ||
+      keep > previous.blocks.size()) {
+    return false;
+  }
+  stamp.cycle = previous.cycle + static_cast<uint64_t>(cycle);
+  stamp.time = previous.time + time;
+  stamp.buddy = buddy != 0;
+  stamp.strategy = names[strategyId];
+  stamp.maxMemory = previous.maxMemory + static_cast<int>(maxMemory);
+  stamp.processCount = previous.processCount + static_cast<int>(processCount);
+  stamp.externalFragmentation =
+      previous.externalFragmentation + static_cast<int>(external);
+  stamp.internalFragmentation =
+      previous.internalFragmentation + static_cast<int>(internal);
+  stamp.largestFreeBlock = previous.largestFreeBlock + static_cast<int>(largest);
+
+  stamp.blocks.assign(previous.blocks.begin(), previous.blocks.begin() + keep);
+  for (uint64_t i = 0; i < count; ++i) {
+    int64_t start;
+    uint64_t size, requested, owner;
+    if (!getSigned(in, start) || !getVarint(in, size) ||
+        !getVarint(in, requested) || !getVarint(in, owner) ||
+        owner > names.size()) {
+      return false;
+    }
+    MemoryStamp::Block block;
+    block.start = nextStart(stamp.blocks) + static_cast<int>(start);
+    block.size = static_cast<int>(size);
+    block.requested = static_cast<int>(requested);
+    if (owner != 0) {
+      block.owner = names[owner - 1];
+    }
+    stamp.blocks.push_back(std::move(block));
+  }
+  previous = stamp;
+  return true;
+}
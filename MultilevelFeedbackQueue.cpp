@@ -0,0 +1,69 @@
+#include "headers/MultilevelFeedbackQueue.h"
+
+#include <algorithm>
+#include <bit>
+
+MultilevelFeedbackQueue::MultilevelFeedbackQueue(std::vector<int> levelQuantums)
+    : levelQuantums(std::move(levelQuantums)) {
+  if (this->levelQuantums.empty()) {
+    this->levelQuantums.push_back(1);
+  }
+  if (this->levelQuantums.size() > MAX_LEVELS) {
+    this->levelQuantums.resize(MAX_LEVELS);
+  }
+  levels.resize(this->levelQuantums.size());
+}
+
+void MultilevelFeedbackQueue::push(Process *process) {
+  int level = std::clamp(process->getPriorityLevel(), 0, levelCount() - 1);
+  process->setPriorityLevel(level);
+  levels[level].push_back(process);
+  nonEmptyLevels.fetch_or(uint64_t(1) << level, std::memory_order_relaxed);
+  count++;
+}
+
+Process *MultilevelFeedbackQueue::pop() {
+  uint64_t bitmap = nonEmptyLevels.load(std::memory_order_relaxed);
+  if (bitmap == 0) {
+    return nullptr;
+  }
+  int level = std::countr_zero(bitmap);
+  Process *process = levels[level].front();
+  levels[level].pop_front();
+  if (levels[level].empty()) {
+    nonEmptyLevels.fetch_and(~(uint64_t(1) << level),
+                             std::memory_order_relaxed);
+  }
+  count--;
+  return process;
+}
+
+/*
+ * Moves every waiting process back to the top level so long-running batch
+ * work that sank to the bottom is not starved by newer arrivals.
+ */
+void MultilevelFeedbackQueue::boost() {
+  for (int level = 1; level < levelCount(); ++level) {
+    for (Process *process : levels[level]) {
+      process->setPriorityLevel(0);
+      levels[0].push_back(process);
+    }
+    levels[level].clear();
+  }
+  nonEmptyLevels.store(levels[0].empty() ? 0 : 1, std::memory_order_relaxed);
+}
+
+bool MultilevelFeedbackQueue::hasWorkAbove(int level) const {
+  uint64_t above = (uint64_t(1) << std::min(level, MAX_LEVELS - 1)) - 1;
+  return (nonEmptyLevels.load(std::memory_order_relaxed) & above) != 0;
+}
+
+int MultilevelFeedbackQueue::quantumFor(int level) const {
+  return levelQuantums[std::clamp(level, 0, levelCount() - 1)];
+}
+
+int MultilevelFeedbackQueue::levelCount() const {
+  return static_cast<int>(levels.size());
+}
+
+size_t MultilevelFeedbackQueue::size() const { return count; }
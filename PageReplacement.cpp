@@ -0,0 +1,328 @@
+#include "headers/PageReplacement.h"
+
+#include <algorithm>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// Doubly-linked list threaded through per-frame arrays, so linking and
+// unlinking a frame never allocates. A frame is in at most one list.
+class FrameList {
+public:
+  explicit FrameList(int frameCount)
+      : prev(frameCount, -1), next(frameCount, -1), linked(frameCount, 0) {}
+
+  void pushBack(int frame) {
+    prev[frame] = tail;
+    next[frame] = -1;
+    if (tail != -1) {
+      next[tail] = frame;
+    } else {
+      head = frame;
+    }
+    tail = frame;
+    linked[frame] = 1;
+    count++;
+  }
+
+  void remove(int frame) {
+    if (!linked[frame]) {
+      return;
+    }
+    if (prev[frame] != -1) {
+      next[prev[frame]] = next[frame];
+    } else {
+      head = next[frame];
+    }
+    if (next[frame] != -1) {
+      prev[next[frame]] = prev[frame];
+    } else {
+      tail = prev[frame];
+    }
+    linked[frame] = 0;
+    count--;
+  }
+
+  bool contains(int frame) const { return linked[frame]; }
+  int size() const { return count; }
+
+  // oldest frame that is not pinned, -1 if there is none
+  int firstUnpinned(const std::function<bool(int)> &pinned) const {
+    for (int frame = head; frame != -1; frame = next[frame]) {
+      if (!pinned(frame)) {
+        return frame;
+      }
+    }
+    return -1;
+  }
+
+private:
+  std::vector<int> prev;
+  std::vector<int> next;
+  std::vector<uint8_t> linked;
+  int head = -1;
+  int tail = -1;
+  int count = 0;
+};
+
+class FifoPolicy : public PageReplacementPolicy {
+public:
+  explicit FifoPolicy(int frameCount) : order(frameCount) {}
+
+  void pageLoaded(int frame, uint64_t) override { order.pushBack(frame); }
+  void pageReferenced(int) override {}
+  void pageRemoved(int frame) override { order.remove(frame); }
+
+  int selectVictim(uint64_t, const std::function<bool(int)> &pinned) override {
+    int frame = order.firstUnpinned(pinned);
+    if (frame != -1) {
+      order.remove(frame);
+    }
+    return frame;
+  }
+
+protected:
+  FrameList order; // front is the victim
+};
+
+class LruPolicy : public FifoPolicy {
+public:
+  explicit LruPolicy(int frameCount) : FifoPolicy(frameCount) {}
+
+  void pageReferenced(int frame) override {
+    if (order.contains(frame)) {
+      order.remove(frame);
+      order.pushBack(frame);
+    }
+  }
+};
+
+class ClockPolicy : public PageReplacementPolicy {
+public:
+  explicit ClockPolicy(int frameCount)
+      : resident(frameCount, 0), referenced(frameCount, 0) {}
+
+  void pageLoaded(int frame, uint64_t) override {
+    resident[frame] = 1;
+    referenced[frame] = 1;
+  }
+  void pageReferenced(int frame) override { referenced[frame] = 1; }
+  void pageRemoved(int frame) override { resident[frame] = 0; }
+
+  // Two sweeps are enough: the first clears every reference bit it passes.
+  int selectVictim(uint64_t, const std::function<bool(int)> &pinned) override {
+    int frameCount = static_cast<int>(resident.size());
+    for (int step = 0; step < 2 * frameCount; ++step) {
+      int frame = hand;
+      hand = (hand + 1) % frameCount;
+      if (!resident[frame] || pinned(frame)) {
+        continue;
+      }
+      if (referenced[frame]) {
+        referenced[frame] = 0;
+        continue;
+      }
+      resident[frame] = 0;
+      return frame;
+    }
+    return -1;
+  }
+
+private:
+  std::vector<uint8_t> resident;
+  std::vector<uint8_t> referenced;
+  int hand = 0;
+};
+
+// O(1) LFU: buckets of equal reference counts in ascending order; a
+// reference moves the frame to the next bucket, creating it if needed.
+class LfuPolicy : public PageReplacementPolicy {
+public:
+  explicit LfuPolicy(int frameCount)
+      : bucketOf(frameCount), positionOf(frameCount), resident(frameCount, 0) {}
+
+  void pageLoaded(int frame, uint64_t) override {
+    if (buckets.empty() || buckets.front().count != 1) {
+      buckets.push_front({1, {}});
+    }
+    auto bucket = buckets.begin();
+    bucket->frames.push_back(frame);
+    bucketOf[frame] = bucket;
+    positionOf[frame] = std::prev(bucket->frames.end());
+    resident[frame] = 1;
+  }
+
+  void pageReferenced(int frame) override {
+    if (!resident[frame]) {
+      return;
+    }
+    auto bucket = bucketOf[frame];
+    auto next = std::next(bucket);
+    if (next == buckets.end() || next->count != bucket->count + 1) {
+      next = buckets.insert(next, {bucket->count + 1, {}});
+    }
+    // splice keeps positionOf[frame] valid
+    next->frames.splice(next->frames.end(), bucket->frames, positionOf[frame]);
+    bucketOf[frame] = next;
+    if (bucket->frames.empty()) {
+      buckets.erase(bucket);
+    }
+  }
+
+  void pageRemoved(int frame) override {
+    if (!resident[frame]) {
+      return;
+    }
+    auto bucket = bucketOf[frame];
+    bucket->frames.erase(positionOf[frame]);
+    if (bucket->frames.empty()) {
+      buckets.erase(bucket);
+    }
+    resident[frame] = 0;
+  }
+
+  int selectVictim(uint64_t, const std::function<bool(int)> &pinned) override {
+    for (const Bucket &bucket : buckets) {
+      for (int frame : bucket.frames) {
+        if (!pinned(frame)) {
+          pageRemoved(frame);
+          return frame;
+        }
+      }
+    }
+    return -1;
+  }
+
+private:
+  struct Bucket {
+    uint64_t count;
+    std::list<int> frames; // least recently promoted first
+  };
+
+  std::list<Bucket> buckets;
+  std::vector<std::list<Bucket>::iterator> bucketOf;
+  std::vector<std::list<int>::iterator> positionOf;
+  std::vector<uint8_t> resident;
+};
+
+// Recently evicted page ids, oldest first, with O(1) lookup.
+class GhostList {
+public:
+  void pushBack(uint64_t page) {
+    order.push_back(page);
+    index[page] = std::prev(order.end());
+  }
+  bool erase(uint64_t page) {
+    auto it = index.find(page);
+    if (it == index.end()) {
+      return false;
+    }
+    order.erase(it->second);
+    index.erase(it);
+    return true;
+  }
+  void popFront() {
+    index.erase(order.front());
+    order.pop_front();
+  }
+  bool contains(uint64_t page) const { return index.count(page) != 0; }
+  int size() const { return static_cast<int>(order.size()); }
+
+private:
+  std::list<uint64_t> order;
+  std::unordered_map<uint64_t, std::list<uint64_t>::iterator> index;
+};
+
+/*
+ * ARC (Megiddo and Modha). t1 holds pages referenced once, t2 pages
+ * referenced again; b1 and b2 remember pages recently evicted from each.
+ * A fault on a page in b1 grows the target size of t1, one in b2 shrinks it.
+ */
+class ArcPolicy : public PageReplacementPolicy {
+public:
+  explicit ArcPolicy(int frameCount)
+      : capacity(frameCount), t1(frameCount), t2(frameCount),
+        pageOf(frameCount, 0) {}
+
+  void pageLoaded(int frame, uint64_t page) override {
+    pageOf[frame] = page;
+    if (b1.contains(page)) {
+      target = std::min(capacity,
+                        target + std::max(b2.size() / b1.size(), 1));
+      b1.erase(page);
+      t2.pushBack(frame);
+    } else if (b2.contains(page)) {
+      target = std::max(0, target - std::max(b1.size() / b2.size(), 1));
+      b2.erase(page);
+      t2.pushBack(frame);
+    } else {
+      t1.pushBack(frame);
+    }
+  }
+
+  void pageReferenced(int frame) override {
+    if (t1.contains(frame)) {
+      t1.remove(frame);
+      t2.pushBack(frame);
+    } else if (t2.contains(frame)) {
+      t2.remove(frame);
+      t2.pushBack(frame);
+    }
+  }
+
+  void pageRemoved(int frame) override {
+    t1.remove(frame);
+    t2.remove(frame);
+  }
+
+  int selectVictim(uint64_t incomingPage,
+                   const std::function<bool(int)> &pinned) override {
+    bool fromT1 = t1.size() > 0 &&
+                  (t1.size() > target ||
+                   (b2.contains(incomingPage) && t1.size() == target));
+    int frame = (fromT1 ? t1 : t2).firstUnpinned(pinned);
+    if (frame == -1) {
+      fromT1 = !fromT1;
+      frame = (fromT1 ? t1 : t2).firstUnpinned(pinned);
+    }
+    if (frame == -1) {
+      return -1;
+    }
+    (fromT1 ? t1 : t2).remove(frame);
+    GhostList &ghosts = fromT1 ? b1 : b2;
+    ghosts.pushBack(pageOf[frame]);
+    if (ghosts.size() > capacity) {
+      ghosts.popFront();
+    }
+    return frame;
+  }
+
+private:
+  int capacity;
+  int target = 0; // preferred size of t1
+  FrameList t1;
+  FrameList t2;
+  GhostList b1;
+  GhostList b2;
+  std::vector<uint64_t> pageOf;
+};
+
+} // namespace
+
+PageReplacementPolicy *PageReplacementPolicy::create(const std::string &name,
+                                                     int frameCount) {
+  if (name == "fifo") {
+    return new FifoPolicy(frameCount);
+  } else if (name == "lru") {
+    return new LruPolicy(frameCount);
+  } else if (name == "clock") {
+    return new ClockPolicy(frameCount);
+  } else if (name == "lfu") {
+    return new LfuPolicy(frameCount);
+  } else if (name == "arc") {
+    return new ArcPolicy(frameCount);
+  }
+  return nullptr;
+}
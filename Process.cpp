@@ -1,7 +1,12 @@
 #include "headers/Process.h"
 
+#include <algorithm>
+#include <atomic>
+
+static std::atomic<int> nextPid = 0;
+
 Process::Process(std::string processName)
-    : processName(std::move(processName)) {}
+    : processName(std::move(processName)), pid(nextPid++) {}
 
 void Process::setInstructionsDone(int instructions) {
   instructionsDone = instructions;
@@ -13,6 +18,8 @@ void Process::setProcessSize(int processSize) {
   this->processSize = processSize;
 }
 
+void Process::setPriorityLevel(int level) { priorityLevel = level; }
+
 void Process::setDone(bool done) { isDone = done; }
 
 void Process::setScreenName(std::string screenName) {
@@ -22,24 +29,142 @@ void Process::setRunning(bool running) { isRunning = running; }
 
 void Process::setWaiting(bool waiting) { isWaiting = waiting; }
 
+void Process::setBlocked(bool blocked) { isBlocked = blocked; }
+
 void Process::setInstructionsTotal(int instructions) {
   instructionsTotal = instructions;
 }
 
+void Process::setProgram(Program program) {
+  this->program = std::move(program);
+  instructionsTotal = this->program.instructionCount;
+  // PRINT never reallocates the log, so readers can look at the published
+  // part of it while the process runs
+  execution.printLog.reserve(this->program.printCount);
+}
+
 std::string Process::getProcessName() const { return processName; }
 
+int Process::getPid() const { return pid; }
+
 int Process::getInstructionsDone() const { return instructionsDone; }
 
 int Process::getCoreAssigned() const { return coreAssigned; }
 
 int Process::getProcessSize() const { return processSize; }
 
+int Process::getPriorityLevel() const { return priorityLevel; }
+
 bool Process::getDone() const { return isDone; }
 
 bool Process::getRunning() const { return isRunning; }
 
 bool Process::getWaiting() const { return isWaiting; }
 
+bool Process::getBlocked() const { return isBlocked; }
+
 std::string Process::getScreenName() const { return screenName; }
 
 int Process::getInstructionsTotal() const { return instructionsTotal; }
+
+int Process::getRemainingInstructions() const {
+  return instructionsTotal - instructionsDone;
+}
+
+std::span<const PrintRecord> Process::getPrintLog() const {
+  return {execution.printLog.data(),
+          printsPublished.load(std::memory_order_acquire)};
+}
+
+const Program &Process::getProgram() const { return program; }
+
+void Process::grantQuantum(int quantum) {
+  if (!task.valid()) {
+    task = instructionStream();
+  }
+  task.grantQuantum(quantum);
+}
+
+ProcessEvent Process::resume() {
+  if (!task.valid()) {
+    task = instructionStream();
+  }
+  return task.resume();
+}
+
+/*
+ * Works out which pages the next instruction references and returns the
+ * first one that is not resident, or -1. Code addresses wrap around the
+ * process' address space; variables live in its last bytes.
+ */
+int Process::findMissingPage() {
+  const Instruction &instruction = program.code[execution.pc];
+  int addressSpace = std::max(processSize, 1);
+  int pageCount = static_cast<int>(pageTable.size());
+  int codeAddress = static_cast<int>(
+      execution.pc * sizeof(Instruction) % addressSpace);
+  touchedPages = {std::min(codeAddress / pageSize, pageCount - 1), -1};
+
+  bool namesVariable =
+      instruction.opcode == OP_DECLARE || instruction.opcode == OP_ADD ||
+      instruction.opcode == OP_SUBTRACT ||
+      (instruction.opcode == OP_PRINT && (instruction.flags & PRINT_VARIABLE));
+  if (namesVariable) {
+    int dataBase = std::max(
+        addressSpace - MAX_VARIABLES * static_cast<int>(sizeof(uint16_t)), 0);
+    int dataAddress =
+        (dataBase + instruction.a * static_cast<int>(sizeof(uint16_t))) %
+        addressSpace;
+    touchedPages[1] = std::min(dataAddress / pageSize, pageCount - 1);
+  }
+
+  for (int page : touchedPages) {
+    if (page != -1 && pageTable[page].frame.load(std::memory_order_relaxed) ==
+                          -1) {
+      return page;
+    }
+  }
+  return -1;
+}
+
+// Repeats of the last two pages are dropped, so a loop over one code page
+// and one data page does not grow the log.
+void Process::logReference(int page) {
+  memoryReferences++;
+  pendingReferences++;
+  size_t logged = referenceLog.size();
+  if ((logged > 0 && referenceLog[logged - 1] == page) ||
+      (logged > 1 && referenceLog[logged - 2] == page)) {
+    return;
+  }
+  referenceLog.push_back(page);
+}
+
+ProcessTask Process::instructionStream() {
+  while (!execution.finished) {
+    if (demandPaged) {
+      while ((faultingPage = findMissingPage()) != -1) {
+        pageFaults++;
+        co_yield PAGE_FAULT;
+      }
+      for (int page : touchedPages) {
+        if (page != -1) {
+          logReference(page);
+        }
+      }
+    }
+    instructionsDone += Interpreter::execute(program, execution, 1);
+    printsPublished.store(execution.printLog.size(), std::memory_order_release);
+    if (execution.finished) {
+      break;
+    }
+    if (execution.sleepTicks > 0) {
+      // SLEEP gives the core up until its ticks have passed
+      sleepTicks = execution.sleepTicks;
+      execution.sleepTicks = 0;
+      co_yield PROCESS_BLOCKED;
+      continue;
+    }
+    co_yield INSTRUCTION_RETIRED;
+  }
+}
@@ -0,0 +1,39 @@
+#include "headers/RunQueue.h"
+
+void RunQueue::push(Process *process) {
+  std::lock_guard<std::mutex> lock(queueMutex);
+  processes.push_back(process);
+  count.fetch_add(1, std::memory_order_release);
+}
+
+Process *RunQueue::pop() {
+  if (empty()) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(queueMutex);
+  if (processes.empty()) {
+    return nullptr;
+  }
+  Process *process = processes.front();
+  processes.pop_front();
+  count.fetch_sub(1, std::memory_order_release);
+  return process;
+}
+
+Process *RunQueue::steal() {
+  if (empty()) {
+    return nullptr;
+  }
+  std::unique_lock<std::mutex> lock(queueMutex, std::try_to_lock);
+  if (!lock.owns_lock() || processes.empty()) {
+    return nullptr;
+  }
+  Process *process = processes.front();
+  processes.pop_front();
+  count.fetch_sub(1, std::memory_order_release);
+  return process;
+}
+
+size_t RunQueue::size() const { return count.load(std::memory_order_acquire); }
+
+bool RunQueue::empty() const { return size() == 0; }
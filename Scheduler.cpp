@@ -4,6 +4,8 @@
 #include <chrono>
 #include <cstdlib>
 // #include <format>
+#include <algorithm>
+#include <climits>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
@@ -12,11 +14,17 @@
 #include <thread>
 
 Scheduler::Scheduler(Config config, std::vector<Process *> *processVector)
-    : config(config),
+    : config(config), mlfq(config.getMlfqQuantums()),
+      statusBoard(config.getNumCpu()),
       memoryManager(config.getMaxOverallMemory(), config.getMemoryPerFrame(),
                     config.getMinMemoryPerProcess(),
                     config.getMaxMemoryPerProcess(),
-                    config.getMemoryPerFrame()) {
+                    config.getMemoryPerFrame(), config.getPageReplacement(),
+                    config.getAllocationStrategy(), config.getMemoryMode(),
+                    config.getCompactionThreshold(),
+                    config.getCompactionRate(), config.getSwapSize(),
+                    config.getSwapMmap(), config.getNumCpu()),
+      stampRecorder("memory_stamps/memory_stamps.bin", 256) {
     numCores = config.getNumCpu();
     schedulingAlgorithm = config.getScheduler();
     quantumCycles = config.getQuantumCycles();
@@ -26,6 +34,27 @@ Scheduler::Scheduler(Config config, std::vector<Process *> *processVector)
     delaysPerExecution = config.getDelaysPerExec();
     this->processVector = processVector;
     this->globalExecDelay = (delaysPerExecution + 1) * 100;
+    virtualMode = config.getSimMode() == "virtual";
+    mlfqBoostInterval = std::max(config.getMlfqBoostInterval(), 1);
+    ticksPerStep = virtualMode ? delaysPerExecution + 1 : 1;
+    tenantTickets = config.getTenantTickets();
+    tenantTicks = std::vector<std::atomic<uint64_t>>(tenantTickets.size());
+    memoryMode = config.getMemoryMode();
+    demandPaging = memoryMode == "paging" && config.getPagingMode() == "demand";
+    swapLatency = std::max(config.getSwapLatency(), 0);
+    maxResidentProcs = std::max(config.getMaxResidentProcs(), 0);
+    if (demandPaging && maxResidentProcs == 0) {
+        // Demand paging reserves nothing on admission, so without a limit
+        // every process would get in. Default to one process per frame, and
+        // no more than memory and swap can hold whole, so a full swap file
+        // cannot leave every resident process waiting for a page.
+        int frames = static_cast<int>(memoryManager.frameTable.size());
+        int pagesPerProcess = std::max(
+                (memoryManager.maxMemoryPerProcess + memoryManager.frameSize - 1) /
+                memoryManager.frameSize, 1);
+        int pages = frames + memoryManager.swapSpace.totalSlots();
+        maxResidentProcs = std::max(std::min(frames, pages / pagesPerProcess), 1);
+    }
 
     coreVector.resize(numCores);
     // Initialize the coreVector
@@ -33,282 +62,889 @@ Scheduler::Scheduler(Config config, std::vector<Process *> *processVector)
         coreVector[i].coreIndex = i;
         coreVector[i].state = CoreState::IDLE;
         coreVector[i].process = nullptr;
-        coreVector[i].thread = nullptr;
+        coreVector[i].runQueue = new RunQueue();
+    }
+    // virtual runs keep swap I/O synchronous so they stay deterministic
+    if (!virtualMode && memoryMode == "paging") {
+        memoryManager.startSwapIo(
+            [this](Process *process) { wakeFromSwap(process); });
     }
+    stampRecorder.start();
 }
 
-void Scheduler::addProcessToReadyQueue(Process *process) { {
-        std::lock_guard<std::mutex> lock(mtx);
-        readyQueue.push(process);
+/*
+ * Queues a process on a core's run queue. Without a core (new processes) the
+ * queues are filled round-robin so work starts out spread across cores.
+ * Priority schedulers keep a single global ready set instead.
+ */
+void Scheduler::addProcessToReadyQueue(Process *process, int cpuIndex) {
+    if (schedulingAlgorithm == "mlfq") {
+        std::lock_guard<std::mutex> lock(readySetMutex);
+        mlfq.push(process);
+    } else if (schedulingAlgorithm == "sjf" || schedulingAlgorithm == "srtf") {
+        std::lock_guard<std::mutex> lock(readySetMutex);
+        remainingTimeHeap.push(process, {process->getRemainingInstructions(),
+                                         readySequence++});
+        shortestReadyRemaining = remainingTimeHeap.topKey().first;
+    } else if (schedulingAlgorithm == "stride") {
+        std::lock_guard<std::mutex> lock(readySetMutex);
+        // a process that was away does not get to catch up on missed passes
+        process->pass = std::max(process->pass, globalPass);
+        passHeap.push(process, {process->pass, readySequence++});
+    } else if (schedulingAlgorithm == "edf") {
+        std::lock_guard<std::mutex> lock(readySetMutex);
+        uint64_t deadline = process->deadline == 0 ? UINT64_MAX : process->deadline;
+        deadlineHeap.push(process, {deadline, readySequence++});
+        earliestReadyDeadline = deadlineHeap.topKey().first;
+    } else {
+        if (cpuIndex < 0) {
+            cpuIndex = nextRunQueue.fetch_add(1) % numCores;
+        }
+        coreVector[cpuIndex].runQueue->push(process);
+    }
+    readyCount.fetch_add(1);
+
+    if (virtualMode) { {
+            std::lock_guard<std::mutex> lock(mtx);
+            virtualWakePending = true;
+        }
+        cv.notify_one();
+    } else if (coreExecutor != nullptr) {
+        coreExecutor->wakeOne();
     }
-    cv.notify_one(); // Notify outside the lock
 }
 
-void Scheduler::addCustomProcess(Process *process) { {
+/*
+ * Admits a new process and queues it. Returns false if edf admission control
+ * rejected it; the process is then not queued.
+ */
+bool Scheduler::addCustomProcess(Process *process) {
+    process->arrivalTick = currentTick();
+    if (process->getProcessSize() <= 0) {
+        process->setProcessSize(rand() % (config.getMaxMemoryPerProcess() -
+                                          config.getMinMemoryPerProcess() + 1) +
+                                config.getMinMemoryPerProcess());
+    }
+    process->tenant = std::clamp(process->tenant, 0,
+                                 static_cast<int>(tenantTickets.size()) - 1);
+    process->tickets = std::max(tenantTickets[process->tenant], 1);
+    if (process->relativeDeadline != 0) {
+        process->deadline = process->arrivalTick + process->relativeDeadline;
+    }
+    if (schedulingAlgorithm == "edf" && !passesDeadlineAdmission(process)) {
+        rejectedProcesses++;
+        return false;
+    } {
         std::lock_guard<std::mutex> lock(mtx);
-        readyQueue.push(process);
         processVector->push_back(process);
     }
-    cv.notify_one();
+    addProcessToReadyQueue(process);
+    return true;
 }
 
-void Scheduler::generateDummyProcesses() {
-    while (schedulerTestRunning) {
-        int generatedInstructions =
-                rand() % (maxInstructions - minimumInstructions + 1) +
-                minimumInstructions;
-
-        int memorySize = rand() % (config.getMaxMemoryPerProcess() -
-                                   config.getMinMemoryPerProcess() + 1) +
-                         config.getMinMemoryPerProcess();
-        auto *newProcess = new Process("Process_" + std::to_string(processCounter));
-        newProcess->setInstructionsTotal(generatedInstructions);
-        newProcess->setProcessSize(memorySize);
-        newProcess->setWaiting(true); {
-            std::lock_guard<std::mutex> lock(mtx);
-            processVector->push_back(newProcess);
+/*
+ * Rejects a deadline job only if the admitted set provably cannot meet every
+ * deadline: the job alone must fit before its deadline, and for every
+ * admitted deadline d the work due by d may not exceed what the cores can
+ * execute until d. Jobs without a deadline are always admitted.
+ */
+bool Scheduler::passesDeadlineAdmission(Process *process) {
+    if (process->deadline == 0) {
+        return true;
+    }
+    uint64_t now = currentTick();
+    uint64_t demand = process->getRemainingInstructions() * ticksPerStep;
+    if (now + demand > process->deadline) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(readySetMutex);
+    uint64_t cumulative = 0;
+    bool counted = false;
+    for (const auto &[deadline, admitted]: admittedDeadlines) {
+        if (!counted && process->deadline <= deadline) {
+            cumulative += demand;
+            counted = true;
+            if (cumulative > (process->deadline - std::min(now, process->deadline)) *
+                             numCores) {
+                return false;
+            }
+        }
+        cumulative += admitted->getRemainingInstructions() * ticksPerStep;
+        if (counted && cumulative > (deadline - std::min(now, deadline)) * numCores) {
+            return false;
         }
+    }
+    if (!counted && cumulative + demand >
+                    (process->deadline - now) * numCores) {
+        return false;
+    }
+    admittedDeadlines.insert({process->deadline, process});
+    return true;
+}
+
+Process *Scheduler::createDummyProcess() {
+    int generatedInstructions =
+            rand() % (maxInstructions - minimumInstructions + 1) +
+            minimumInstructions;
+    auto *newProcess = new Process("Process_" + std::to_string(processCounter));
+    newProcess->setProgram(Interpreter::generateProgram(generatedInstructions));
+    newProcess->setWaiting(true);
+    newProcess->tenant = processCounter % tenantTickets.size();
+    if (config.getMaxDeadline() > 0) {
+        newProcess->relativeDeadline =
+                rand() % (config.getMaxDeadline() - config.getMinDeadline() + 1) +
+                config.getMinDeadline();
+    }
+    processCounter++;
+    return newProcess;
+}
 
-        addProcessToReadyQueue(newProcess);
+void Scheduler::submitDummyProcess() {
+    Process *newProcess = createDummyProcess();
+    if (!addCustomProcess(newProcess)) {
+        delete newProcess;
+    }
+}
 
-        processCounter++;
+void Scheduler::generateDummyProcesses() {
+    while (schedulerTestRunning) {
+        submitDummyProcess();
         std::this_thread::sleep_for(
             std::chrono::milliseconds(batchProcessFrequency));
     }
 }
 
-void Scheduler::runFCFSScheduler(int cpuIndex) {
-    while (schedulerTestRunning || !readyQueue.empty()) {
-        Process *currentProcess; {
-            std::unique_lock<std::mutex> lock(mtx);
-            cv.wait(lock,
-                    [this] { return !readyQueue.empty() || !schedulerTestRunning; });
+/*
+ * Memory admission for a process about to be dispatched. Returns false if the
+ * process could not be brought into memory; it is then parked on the
+ * memory-wait queue. Newcomers queue behind earlier waiters instead of
+ * overtaking them, unless headBlocksAdmission lets them past. Nothing new is
+ * admitted while max-resident-procs processes are in memory.
+ */
+bool Scheduler::loadIntoMemory(Process *process, int cpuIndex) {
+    std::lock_guard<std::mutex> lock(admissionMutex);
+    if (process->memoryResident) {
+        return true;
+    }
+    bool mustWait = (!process->memoryRetry && headBlocksAdmission()) ||
+                    (maxResidentProcs > 0 && residentCount >= maxResidentProcs);
+    if (mustWait) {
+        parkOnMemory(process);
+        return false;
+    }
+    if (!allocateProcessMemory(process, cpuIndex)) {
+        process->memoryStalls++;
+        parkOnMemory(process);
+        return false;
+    }
+    process->memoryResident = true;
+    process->memoryRetry = false;
+    process->memoryStalls = 0;
+    residentCount++;
+    return true;
+}
+
+/*
+ * Called with admissionMutex held. A head that has not tried to allocate yet
+ * keeps its place. Once it has tried and did not fit, processes that fit go
+ * ahead of it, so one process too large for the free memory cannot hold up
+ * everyone behind it. After MEMORY_STALL_LIMIT tries it blocks them again,
+ * unless it could never fit or nothing is left in memory to release.
+ */
+bool Scheduler::headBlocksAdmission() const {
+    if (memoryWaitQueue.empty()) {
+        return false;
+    }
+    const Process *head = memoryWaitQueue.front();
+    if (head->memoryStalls == 0) {
+        return true;
+    }
+    return head->memoryStalls >= MEMORY_STALL_LIMIT && residentCount > 0 &&
+           head->getProcessSize() <= memoryManager.maxMemory;
+}
+
+// Called with admissionMutex held.
+bool Scheduler::allocateProcessMemory(Process *process, int cpuIndex) {
+    if (memoryMode == "flat" || memoryMode == "buddy") {
+        return memoryManager.isProcessInMemory(process->getProcessName()) ||
+               memoryManager.allocateMemory(process->getProcessName(),
+                                            process->getProcessSize());
+    }
+
+    if (demandPaging) {
+        // pages are brought in one at a time as the process faults on them
+        memoryManager.preparePageTable(process);
+        return true;
+    }
+    if (memoryManager.isProcessinPagingMemory(process)) {
+        return true;
+    }
+    // if not in memory, allocate memory
+    int processPageReq =
+            std::ceil(static_cast<double>(process->getProcessSize()) /
+                      memoryManager.frameSize);
+    if (memoryManager.pagingAllocate(process, processPageReq, cpuIndex)) {
+        return true;
+    }
+    // if memory allocation fails, de-allocate the least recently used process
+    // and allocate the current process, but only if the oldest process' frames
+    // are big enough to fit the current process
+    Process *oldestProcess = memoryManager.getLeastRecentlyUsedProcess();
+    if (oldestProcess == nullptr) {
+        return false;
+    }
+    int oldestProcessPageReq = std::ceil(
+        static_cast<double>(oldestProcess->getProcessSize()) /
+        memoryManager.frameSize);
+    if (oldestProcessPageReq < processPageReq) {
+        return false;
+    }
+    if (!memoryManager.pagingDeallocate(oldestProcess, true, cpuIndex)) {
+        return false;
+    }
+    oldestProcess->memoryResident = false;
+    residentCount--;
+    return memoryManager.pagingAllocate(process, processPageReq, cpuIndex);
+}
+
+// Called with admissionMutex held. A woken waiter that still does not fit
+// goes back to the front, keeping its place. A demand-paged fault is already
+// admitted, so it queues ahead of every process that is not.
+void Scheduler::parkOnMemory(Process *process) {
+    if (process->memoryResident) {
+        process->memoryRetry = false;
+        auto admitted = std::find_if(
+                memoryWaitQueue.begin(), memoryWaitQueue.end(),
+                [](const Process *waiter) { return !waiter->memoryResident; });
+        memoryWaitQueue.insert(admitted, process);
+    } else if (process->memoryRetry) {
+        process->memoryRetry = false;
+        memoryWaitQueue.push_front(process);
+    } else {
+        memoryWaitQueue.push_back(process);
+    }
+    memoryWaitCount = static_cast<int>(memoryWaitQueue.size());
+}
 
-            if (!schedulerTestRunning && readyQueue.empty()) {
-                return;
+/*
+ * Called with admissionMutex held once memory was freed. Takes waiters off
+ * the front of the memory-wait queue, in order, while the free memory and the
+ * admission limit have room for them. The head is always retried, since
+ * paging can still make room by swapping a process out. When the head does
+ * not block admission it is not counted against the free memory, and the
+ * waiters behind it that fit are taken even past ones that do not. The
+ * caller requeues them after dropping the lock.
+ */
+std::vector<Process *> Scheduler::takeMemoryWaiters() {
+    std::vector<Process *> woken;
+    // demand paging admits without reserving memory up front
+    int budget = demandPaging ? INT_MAX : memoryManager.getFreeMemory(memoryMode);
+    int admitted = residentCount;
+    bool backfill = !headBlocksAdmission();
+    for (auto it = memoryWaitQueue.begin(); it != memoryWaitQueue.end();) {
+        if (maxResidentProcs > 0 && admitted >= maxResidentProcs) {
+            break;
+        }
+        Process *waiter = *it;
+        if (waiter->memoryResident) {
+            // a demand-paged fault: already admitted, it only retries
+            it = memoryWaitQueue.erase(it);
+            waiter->memoryRetry = true;
+            woken.push_back(waiter);
+            continue;
+        }
+        bool head = woken.empty() && it == memoryWaitQueue.begin();
+        if (!head && waiter->getProcessSize() > budget) {
+            if (!backfill) {
+                break;
             }
+            ++it;
+            continue;
+        }
+        if (!head || !backfill) {
+            budget -= std::min(waiter->getProcessSize(), budget);
+        }
+        it = memoryWaitQueue.erase(it);
+        admitted++;
+        waiter->memoryRetry = true;
+        woken.push_back(waiter);
+    }
+    memoryWaitCount = static_cast<int>(memoryWaitQueue.size());
+    return woken;
+}
 
-            currentProcess = readyQueue.front();
-            readyQueue.pop();
+void Scheduler::releaseMemory(Process *process, int cpuIndex) {
+    std::vector<Process *> woken;
+    {
+        std::lock_guard<std::mutex> lock(admissionMutex);
+        if (memoryMode == "flat" || memoryMode == "buddy") {
+            memoryManager.deallocateMemory(process->getProcessName());
+        } else {
+            memoryManager.pagingDeallocate(process, false, cpuIndex);
         }
+        if (process->memoryResident) {
+            process->memoryResident = false;
+            residentCount--;
+        }
+        woken = takeMemoryWaiters();
+    }
+    for (Process *waiter: woken) {
+        addProcessToReadyQueue(waiter);
+    }
+}
 
-        coreVector[cpuIndex].process = currentProcess;
-        coreVector[cpuIndex].state = CoreState::RUNNING;
+/*
+ * Paging can always make room by swapping something out, so while processes
+ * wait for memory the head is retried whenever a process leaves its core on
+ * quantum expiry. In process paging it swaps out the least recently
+ * dispatched process, which keeps the round-robin swap rotation going; a
+ * demand-paged fault retries with the frames the preempted process unpinned.
+ * Returns true if a waiter was woken and the caller should give up its core.
+ */
+bool Scheduler::rotateMemoryWaiters() {
+    if (memoryMode != "paging" || memoryWaitCount == 0) {
+        return false;
+    }
+    Process *waiter;
+    {
+        std::lock_guard<std::mutex> lock(admissionMutex);
+        if (memoryWaitQueue.empty()) {
+            return false;
+        }
+        waiter = memoryWaitQueue.front();
+        if (!waiter->memoryResident && maxResidentProcs > 0 &&
+            residentCount >= maxResidentProcs) {
+            // it would only be parked again
+            return false;
+        }
+        memoryWaitQueue.pop_front();
+        waiter->memoryRetry = true;
+        memoryWaitCount = static_cast<int>(memoryWaitQueue.size());
+    }
+    addProcessToReadyQueue(waiter);
+    return true;
+}
 
-        currentProcess->setCoreAssigned(cpuIndex);
-        currentProcess->setRunning(true);
-        currentProcess->setWaiting(false);
+/*
+ * Services a demand-paging fault on the core: the faulting page is loaded and
+ * the instruction retries on the next step. If no frame can be freed the
+ * process gives the core up and waits on the memory-wait queue.
+ */
+void Scheduler::handlePageFault(int cpuIndex) {
+    Process *process = coreVector[cpuIndex].process;
+    // the counter is only compared in virtual mode, where one thread runs
+    uint64_t swapReads = virtualMode ? memoryManager.swapReads.load() : 0;
+    bool loaded = memoryManager.pageIn(process, process->faultingPage, cpuIndex);
+    if (!loaded) {
+        memoryManager.recordReferences(process, true);
+        // retried under admissionMutex, so a release cannot slip in between
+        // the failed page-in and the park
+        std::lock_guard<std::mutex> lock(admissionMutex);
+        loaded = memoryManager.pageIn(process, process->faultingPage, cpuIndex);
+        if (!loaded) {
+            Core &core = coreVector[cpuIndex];
+            process->setRunning(false);
+            process->setWaiting(true);
+            core.process = nullptr;
+            core.state = CoreState::IDLE;
+            process->memoryStalls++;
+            parkOnMemory(process);
+            return;
+        }
+    }
+    swapReads = virtualMode ? memoryManager.swapReads - swapReads : 0;
+    process->memoryRetry = false;
+    process->memoryStalls = 0;
+    if (process->pendingPageIns > 0) {
+        // the page is being read from swap; let the core run something else
+        Core &core = coreVector[cpuIndex];
+        process->setRunning(false);
+        core.process = nullptr;
+        core.state = CoreState::IDLE;
+        parkOnSwap(process);
+    } else if (virtualMode && swapReads > 0 && swapLatency > 0) {
+        // the read was synchronous; charge its latency as blocked time
+        blockProcess(cpuIndex, swapLatency);
+    }
+}
 
-        int instructions = currentProcess->getInstructionsTotal();
+/*
+ * Takes a process off the ready path while it has page-ins queued on the swap
+ * I/O thread. Whichever of this and wakeFromSwap sees the last page-in done
+ * second puts the process back in the ready queue, exactly once.
+ */
+void Scheduler::parkOnSwap(Process *process) {
+    process->setWaiting(false);
+    process->setBlocked(true);
+    blockedCount++;
+    process->swapParked = true;
+    if (process->pendingPageIns == 0) {
+        wakeFromSwap(process);
+    }
+}
 
-        currentProcess->startTime = std::time(nullptr);
+// called on the swap I/O thread once the process' last page-in is done
+void Scheduler::wakeFromSwap(Process *process) {
+    if (process->swapParked.exchange(false)) {
+        process->setBlocked(false);
+        process->setWaiting(true);
+        blockedCount--;
+        addProcessToReadyQueue(process);
+    }
+}
 
-        for (int i = 0; i < instructions; ++i) {
-            currentProcess->setInstructionsDone(i + 1);
-            std::this_thread::sleep_for(
-                std::chrono::milliseconds(delaysPerExecution));
-        }
-        currentProcess->endTime = std::time(nullptr);
+// Takes the process on the core off it and blocks it for the given ticks.
+void Scheduler::blockProcess(int cpuIndex, uint64_t ticks) {
+    Core &core = coreVector[cpuIndex];
+    Process *process = core.process;
+    process->setRunning(false);
+    core.process = nullptr;
+    core.state = CoreState::IDLE;
+    sleepProcess(process, ticks);
+}
 
-        currentProcess->setRunning(false);
-        currentProcess->setDone(true);
-        coreVector[cpuIndex].process = nullptr;
-        coreVector[cpuIndex].state = CoreState::IDLE;
+void Scheduler::sleepProcess(Process *process, uint64_t ticks) {
+    process->setWaiting(false);
+    process->setBlocked(true);
+    blockedCount++;
+    uint64_t now = currentTick();
+    std::lock_guard<std::mutex> lock(timerMutex);
+    if (timingWheel.empty()) {
+        // an idle wheel may lag the clock; bring it up to now for free
+        std::vector<Process *> none;
+        timingWheel.advance(now, none);
+    }
+    timingWheel.schedule(process, now + ticks);
+}
 
-        finishedProcesses.push_back(currentProcess);
+// Moves every blocked process whose wake-up tick has come back to the ready
+// queue.
+void Scheduler::wakeExpired(uint64_t now) {
+    std::vector<Process *> expired;
+    {
+        std::lock_guard<std::mutex> lock(timerMutex);
+        timingWheel.advance(now, expired);
+    }
+    for (Process *process : expired) {
+        process->setBlocked(false);
+        process->setWaiting(true);
+        blockedCount--;
+        addProcessToReadyQueue(process);
     }
 }
 
-void Scheduler::runRR(int cpuIndex) {
-    Process *currentProcess = nullptr;
+// real-time mode: turns the timing wheel once per scheduler tick
+void Scheduler::runTimer() {
+    int execDelay =
+            schedulingAlgorithm == "fcfs" ? delaysPerExecution : globalExecDelay;
     while (threadsContinue) {
-        if (currentProcess == nullptr) {
-            std::unique_lock<std::mutex> lock(mtx);
-            cv.wait(lock, [this] { return !readyQueue.empty() || !threadsContinue; });
+        std::this_thread::sleep_for(std::chrono::milliseconds(std::max(execDelay, 1)));
+        wakeExpired(currentTick());
+    }
+}
 
-            if (!threadsContinue && readyQueue.empty()) {
-                return;
-            }
+/*
+ * Pops the next process from the core's own run queue, or steals one from
+ * another core when the local queue is empty.
+ */
+Process *Scheduler::takeReadyProcess(int cpuIndex) {
+    if (readyCount.load() == 0) {
+        return nullptr;
+    }
+    Process *process = nullptr;
+    if (schedulingAlgorithm == "mlfq") {
+        std::lock_guard<std::mutex> lock(readySetMutex);
+        uint64_t now = currentTick();
+        if (now - lastBoostTick >= static_cast<uint64_t>(mlfqBoostInterval)) {
+            lastBoostTick = now;
+            // queued processes are boosted here, running ones by their core
+            mlfq.boost();
+            boostEpoch++;
+        }
+        process = mlfq.pop();
+        if (process != nullptr) {
+            process->boostEpoch = boostEpoch;
+        }
+    } else if (schedulingAlgorithm == "sjf" || schedulingAlgorithm == "srtf") {
+        std::lock_guard<std::mutex> lock(readySetMutex);
+        process = remainingTimeHeap.pop();
+        shortestReadyRemaining = remainingTimeHeap.empty()
+                                     ? INT_MAX
+                                     : remainingTimeHeap.topKey().first;
+    } else if (schedulingAlgorithm == "stride") {
+        std::lock_guard<std::mutex> lock(readySetMutex);
+        process = passHeap.pop();
+        if (process != nullptr) {
+            globalPass = process->pass;
+        }
+    } else if (schedulingAlgorithm == "edf") {
+        std::lock_guard<std::mutex> lock(readySetMutex);
+        process = deadlineHeap.pop();
+        earliestReadyDeadline = deadlineHeap.empty() ? UINT64_MAX
+                                                     : deadlineHeap.topKey().first;
+    } else {
+        process = coreVector[cpuIndex].runQueue->pop();
+        for (int i = 1; process == nullptr && i < numCores; ++i) {
+            process = coreVector[(cpuIndex + i) % numCores].runQueue->steal();
+        }
+    }
+    if (process != nullptr) {
+        readyCount.fetch_sub(1);
+    }
+    return process;
+}
 
-            currentProcess = readyQueue.front();
-            if (currentProcess == nullptr) {
-                // null check
-                continue;
-            }
+bool Scheduler::usesGlobalReadySet() const {
+    return schedulingAlgorithm == "mlfq" || schedulingAlgorithm == "sjf" ||
+           schedulingAlgorithm == "srtf" || schedulingAlgorithm == "edf" ||
+           schedulingAlgorithm == "stride";
+}
 
-            // std::cout << "Next Process: " << currentProcess->getProcessName() <<
-            // std::endl;
-            readyQueue.pop();
-        } {
-            std::lock_guard<std::mutex> lock(memoryManagerMutex);
-            // TODO: I think `memoryManager.minMemoryPerProcess` is not correct.
-            // Should be referring to Process memorySize
-            if (!memoryManager.isProcessInMemory(currentProcess->getProcessName()) &&
-                !memoryManager.allocateMemory(currentProcess->getProcessName(),
-                                              currentProcess->getProcessSize())) {
-                addProcessToReadyQueue(currentProcess);
-                currentProcess = nullptr;
-                continue;
-            }
-        }
-        // std::cout << "passed checks" << std::endl;
-        coreVector[cpuIndex].process = currentProcess;
-        coreVector[cpuIndex].state = CoreState::RUNNING;
+int Scheduler::quantumFor(Process *process) const {
+    if (schedulingAlgorithm == "fcfs" || schedulingAlgorithm == "sjf" ||
+        schedulingAlgorithm == "srtf" || schedulingAlgorithm == "edf") {
+        return INT_MAX;
+    }
+    if (schedulingAlgorithm == "mlfq") {
+        return mlfq.quantumFor(process->getPriorityLevel());
+    }
+    return quantumCycles;
+}
 
-        currentProcess->setCoreAssigned(cpuIndex);
-        currentProcess->setRunning(true);
-        currentProcess->setWaiting(false);
+/*
+ * Checked after every instruction: mlfq gives the core up as soon as a
+ * process of higher priority is waiting, srtf as soon as a shorter one is and
+ * edf as soon as one with an earlier deadline is.
+ */
+bool Scheduler::shouldYieldCore(int cpuIndex) {
+    Process *process = coreVector[cpuIndex].process;
+    if (schedulingAlgorithm == "mlfq") {
+        catchUpBoost(process);
+        return mlfq.hasWorkAbove(process->getPriorityLevel());
+    }
+    if (schedulingAlgorithm == "srtf") {
+        return shortestReadyRemaining.load() < process->getRemainingInstructions();
+    }
+    if (schedulingAlgorithm == "edf") {
+        uint64_t deadline = process->deadline == 0 ? UINT64_MAX : process->deadline;
+        return earliestReadyDeadline.load() < deadline;
+    }
+    return false;
+}
 
-        int instructions = currentProcess->getInstructionsTotal();
-        int executedInstructions = currentProcess->getInstructionsDone();
-        int remainingInstructions = instructions - executedInstructions;
-        int quantum = std::min(quantumCycles, remainingInstructions);
+// called by the core running process, which is the only one to write it
+void Scheduler::catchUpBoost(Process *process) {
+    uint64_t epoch = boostEpoch.load();
+    if (process->boostEpoch != epoch) {
+        process->boostEpoch = epoch;
+        process->setPriorityLevel(0);
+    }
+}
 
-        if (currentProcess->startTime == 0) {
-            currentProcess->startTime = std::time(nullptr);
-        }
+void Scheduler::onQuantumExpired(int cpuIndex) {
+    Core &core = coreVector[cpuIndex];
+    bool othersWaiting;
+    if (schedulingAlgorithm == "mlfq") {
+        // used its whole quantum: sink one level
+        catchUpBoost(core.process);
+        int level = core.process->getPriorityLevel();
+        core.process->setPriorityLevel(std::min(level + 1, mlfq.levelCount() - 1));
+        othersWaiting = readyCount.load() > 0;
+    } else if (schedulingAlgorithm == "stride") {
+        core.process->pass += STRIDE_ONE / core.process->tickets;
+        othersWaiting = readyCount.load() > 0;
+    } else if (usesGlobalReadySet()) {
+        othersWaiting = readyCount.load() > 0;
+    } else {
+        // other cores steal from their own side, so only local work preempts
+        othersWaiting = !core.runQueue->empty();
+    }
+
+    // in paging a process waiting for memory can take this one's place
+    if (rotateMemoryWaiters() || othersWaiting) {
+        preemptProcess(cpuIndex);
+    } else {
+        core.process->grantQuantum(quantumFor(core.process));
+    }
+}
 
-        for (int i = 0; i < quantum; ++i) {
-            currentProcess->setInstructionsDone(executedInstructions + i + 1);
-            std::this_thread::sleep_for(std::chrono::milliseconds(globalExecDelay));
+bool Scheduler::dispatchProcess(int cpuIndex) {
+    Process *currentProcess;
+    while (true) {
+        currentProcess = takeReadyProcess(cpuIndex);
+        if (currentProcess == nullptr) {
+            return false;
         }
 
-        if (currentProcess->getInstructionsDone() == instructions) {
-            currentProcess->endTime = std::time(nullptr);
-            currentProcess->setRunning(false);
-            currentProcess->setDone(true);
-            coreVector[cpuIndex].process = nullptr;
-            coreVector[cpuIndex].state = CoreState::IDLE;
-            memoryManager.deallocateMemory(currentProcess->getProcessName());
-            finishedProcesses.push_back(currentProcess);
-            currentProcess = nullptr;
-        } else {
-            if (!readyQueue.empty()) {
-                currentProcess->setRunning(false);
-                currentProcess->setWaiting(true);
-                coreVector[cpuIndex].process = nullptr;
-                coreVector[cpuIndex].state = CoreState::IDLE;
-                addProcessToReadyQueue(currentProcess);
-
-                currentProcess = nullptr;
-            }
+        // fcfs runs without memory constraints
+        uint64_t swapReads = virtualMode ? memoryManager.swapReads.load() : 0;
+        if (schedulingAlgorithm != "fcfs" &&
+            !loadIntoMemory(currentProcess, cpuIndex)) {
+            // parked until memory is freed; try the next process
+            continue;
+        }
+        if (virtualMode && swapLatency > 0 &&
+            memoryManager.swapReads != swapReads) {
+            // swapped back in synchronously; blocked for the read's latency
+            sleepProcess(currentProcess, swapLatency);
+            continue;
         }
+        if (currentProcess->pendingPageIns > 0) {
+            // swapped-in pages are still being read; try the next process
+            parkOnSwap(currentProcess);
+            continue;
+        }
+        break;
+    }
+    if (memoryMode == "paging" && !demandPaging) {
+        // the least recently dispatched process is the next to be swapped out
+        memoryManager.touchResident(currentProcess);
+    }
+
+    coreVector[cpuIndex].process = currentProcess;
+    coreVector[cpuIndex].state = CoreState::RUNNING;
+    currentProcess->grantQuantum(quantumFor(currentProcess));
+
+    currentProcess->setCoreAssigned(cpuIndex);
+    currentProcess->setRunning(true);
+    currentProcess->setWaiting(false);
+
+    if (currentProcess->startTime == 0) {
+        currentProcess->startTime = std::time(nullptr);
     }
+    return true;
 }
 
-void Scheduler::runPagingRR(int cpuIndex) {
-    Process *currentProcess = nullptr;
-    while (threadsContinue) {
-        if (currentProcess == nullptr) {
-            std::unique_lock<std::mutex> lock(mtx);
-            cv.wait(lock, [this] { return !readyQueue.empty() || !threadsContinue; });
+void Scheduler::finishProcess(int cpuIndex) {
+    Process *currentProcess = coreVector[cpuIndex].process;
+    currentProcess->endTime = std::time(nullptr);
+    currentProcess->setRunning(false);
+    currentProcess->setDone(true);
+    coreVector[cpuIndex].process = nullptr;
+    coreVector[cpuIndex].state = CoreState::IDLE;
 
-            if (!threadsContinue && readyQueue.empty()) {
-                return;
+    currentProcess->finishTick = currentTick() + ticksPerStep;
+    uint64_t turnaround = currentProcess->finishTick - currentProcess->arrivalTick;
+    uint64_t service = std::min(currentProcess->serviceTicks, turnaround);
+    totalTurnaroundTicks += turnaround;
+    totalWaitingTicks += turnaround - service;
+    completedProcesses++;
+    if (currentProcess->deadline != 0) {
+        if (currentProcess->finishTick > currentProcess->deadline) {
+            missedDeadlines++;
+        }
+        if (schedulingAlgorithm == "edf") {
+            std::lock_guard<std::mutex> lock(readySetMutex);
+            auto range = admittedDeadlines.equal_range(currentProcess->deadline);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == currentProcess) {
+                    admittedDeadlines.erase(it);
+                    break;
+                }
             }
+        }
+    }
 
-            currentProcess = readyQueue.front();
-            if (currentProcess == nullptr) {
-                // null check
-                continue;
-            }
-            readyQueue.pop();
-        }
-        if (currentProcess != nullptr) {
-            // check if process is in memory
-
-            std::lock_guard<std::mutex> lock(memoryManagerMutex);
-            if (!memoryManager.isProcessinPagingMemory(currentProcess)) {
-                // if not in memory, allocate memory
-                int processPageReq =
-                        std::ceil(static_cast<double>(currentProcess->getProcessSize()) /
-                                  memoryManager.frameSize);
-                std::lock_guard<std::mutex> lock(allocateMemoryMutex);
-                if (!memoryManager.pagingAllocate(currentProcess, processPageReq)) {
-                    // if memory allocation fails, de-allocate the oldest process in main memory and allocate the current process
-                    //but first check if the oldest process' frames are big enough to fit the current process
-                    //if not, move the current process to the back of the ready queue
-                    //and continue with the next process
-
-                    std::lock_guard<std::mutex> lock(deallocateMemoryMutex);
-                    Process * oldestProcess = memoryManager.getOldestProcessInFrameMap();
-
-                    if (oldestProcess != nullptr) {
-                        int oldestProcessPageReq = std::ceil(
-                            static_cast<double>(oldestProcess->getProcessSize()) /
-                            memoryManager.frameSize);
-                        if (oldestProcessPageReq < processPageReq) {
-                            addProcessToReadyQueue(currentProcess);
-                            currentProcess = nullptr;
-                            continue;
-                        }
-                        {
-                            memoryManager.pagingDeallocate(oldestProcess);
-                            memoryManager.writeBackingStore(oldestProcess);
-                            memoryManager.pagingAllocate(currentProcess, processPageReq);
-                        }
-                        currentProcess->setRunning(true);
-                    } else {
-                        addProcessToReadyQueue(currentProcess);
-                        currentProcess = nullptr;
-                        continue;
-                    }
+    if (schedulingAlgorithm != "fcfs") {
+        releaseMemory(currentProcess, cpuIndex);
+    }
+    statusBoard.publishFinished(currentProcess);
+    std::lock_guard<std::mutex> lock(mtx);
+    finishedProcesses.push_back(currentProcess);
+}
+
+void Scheduler::preemptProcess(int cpuIndex) {
+    Process *currentProcess = coreVector[cpuIndex].process;
+    currentProcess->setRunning(false);
+    currentProcess->setWaiting(true);
+    coreVector[cpuIndex].process = nullptr;
+    coreVector[cpuIndex].state = CoreState::IDLE;
+    addProcessToReadyQueue(currentProcess, cpuIndex);
+}
 
+/*
+ * Moves a pending flat compaction along by the ticks since it last moved.
+ * Every core calls this, but only the first one to step in a tick gets to
+ * move anything, so compaction-rate is per tick rather than per core.
+ */
+void Scheduler::advanceCompaction() {
+    uint64_t now = currentTick();
+    uint64_t last = lastCompactionTick.load();
+    if (now == last || !lastCompactionTick.compare_exchange_strong(last, now)) {
+        return;
+    }
+    // ticks that passed before the compaction started earn nothing
+    uint64_t ticks = std::min<uint64_t>(now - last, ticksPerStep);
+    if (!memoryManager.compactStep(ticks)) {
+        return;
+    }
+    // compaction done: the free memory is now in one piece
+    std::vector<Process *> woken;
+    {
+        std::lock_guard<std::mutex> lock(admissionMutex);
+        woken = takeMemoryWaiters();
+    }
+    for (Process *waiter: woken) {
+        addProcessToReadyQueue(waiter);
+    }
+}
 
+/*
+ * Resumes the process on the given core for one instruction, dispatching a new
+ * process first if the core is free. Returns false if the core had nothing to
+ * run.
+ */
+bool Scheduler::stepCore(int cpuIndex) {
+    Core &core = coreVector[cpuIndex];
+    if (memoryManager.compactionActive) {
+        advanceCompaction();
+    }
+    if (core.process == nullptr && !dispatchProcess(cpuIndex)) {
+        statusBoard.publishCore(cpuIndex, nullptr);
+        return false;
+    }
 
+    Process *process = core.process;
+    process->serviceTicks += ticksPerStep;
+    tenantTicks[process->tenant] += ticksPerStep;
+    ProcessEvent event = process->resume();
+    bool yields = event == INSTRUCTION_RETIRED && shouldYieldCore(cpuIndex);
+    // references reach the replacement policy in batches, and before the
+    // process may leave the core (a fault flushes in pageIn)
+    if (process->demandPaged) {
+        bool mayLeave = event == QUANTUM_EXPIRED || event == PROCESS_FINISHED ||
+                        event == PROCESS_BLOCKED || yields;
+        if (mayLeave || process->referenceLog.size() >= REFERENCE_BATCH) {
+            memoryManager.recordReferences(process, mayLeave);
+        }
+    }
+    switch (event) {
+        case PROCESS_FINISHED:
+            finishProcess(cpuIndex);
+            break;
+        case QUANTUM_EXPIRED:
+            onQuantumExpired(cpuIndex);
+            break;
+        case INSTRUCTION_RETIRED:
+            if (yields) {
+                preemptProcess(cpuIndex);
+            }
+            break;
+        case PAGE_FAULT:
+            handlePageFault(cpuIndex);
+            break;
+        case PROCESS_BLOCKED:
+            blockProcess(cpuIndex, process->sleepTicks * ticksPerStep);
+            break;
+    }
+    // A preempted or blocked process still used the core for this step, so it
+    // is what the core shows until the next dispatch; otherwise a core that
+    // switches process every quantum would always read as idle.
+    statusBoard.publishCore(cpuIndex,
+                            event == PROCESS_FINISHED ? nullptr : process);
+    return true;
+}
 
+/*
+ * Drives every core, the process generator and the memory stamp reporter from
+ * a single virtual clock. Instead of sleeping, each component schedules its
+ * next event a number of cycles ahead:
+ *   - an instruction costs (delay-per-exec + 1) cycles
+ *   - a new process is generated every batch-process-freq cycles
+ *   - a memory stamp is taken every quantum-cycles cycles
+ */
+void Scheduler::runVirtualSimulation() {
+    const uint64_t cyclesPerInstruction = delaysPerExecution + 1;
+    const uint64_t generateInterval = std::max(batchProcessFrequency, 1);
+    const uint64_t stampInterval = std::max(quantumCycles, 1);
+    std::vector<bool> coreScheduled(numCores, false);
+    bool generatorScheduled = false;
+    bool stampScheduled = false;
+    bool timerScheduled = false;
 
+    while (threadsContinue) {
+        if (schedulerTestRunning && !generatorScheduled) {
+            eventQueue.schedule(currentCycle, GENERATE_PROCESS);
+            generatorScheduled = true;
+        }
+        if (schedulerTestRunning && !stampScheduled) {
+            eventQueue.schedule(currentCycle, MEMORY_STAMP);
+            stampScheduled = true;
+        }
+        if (!timerScheduled && blockedCount > 0) {
+            eventQueue.schedule(currentCycle + 1, TIMER_TICK);
+            timerScheduled = true;
+        }
+        if (virtualWakePending.exchange(false)) {
+            // new work: idle cores look at the ready queue on the next cycle
+            for (int i = 0; i < numCores; ++i) {
+                if (!coreScheduled[i]) {
+                    eventQueue.schedule(currentCycle + 1, CORE_STEP, i);
+                    coreScheduled[i] = true;
                 }
             }
         }
-        coreVector[cpuIndex].process = currentProcess;
-        coreVector[cpuIndex].state = CoreState::RUNNING;
-
-        currentProcess->setCoreAssigned(cpuIndex);
-        currentProcess->setRunning(true);
-        currentProcess->setWaiting(false);
-
-        int instructions = currentProcess->getInstructionsTotal();
-        int executedInstructions = currentProcess->getInstructionsDone();
-        int remainingInstructions = instructions - executedInstructions;
-        int quantum = std::min(quantumCycles, remainingInstructions);
 
-        if (currentProcess->startTime == 0) {
-            currentProcess->startTime = std::time(nullptr);
+        if (eventQueue.empty()) {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [&] {
+                return virtualWakePending ||
+                       (schedulerTestRunning && !generatorScheduled) ||
+                       !threadsContinue;
+            });
+            continue;
         }
 
-        for (int i = 0; i < quantum; ++i) {
-            currentProcess->setInstructionsDone(executedInstructions + i + 1);
-            std::this_thread::sleep_for(std::chrono::milliseconds(globalExecDelay));
-        }
+        SimEvent event = eventQueue.pop();
+        currentCycle = event.tick;
 
-        if (currentProcess->getInstructionsDone() == instructions) {
-            currentProcess->endTime = std::time(nullptr);
-            currentProcess->setRunning(false);
-            currentProcess->setDone(true);
-            coreVector[cpuIndex].process = nullptr;
-            coreVector[cpuIndex].state = CoreState::IDLE; {
-                std::lock_guard<std::mutex> lock(deallocateMemoryMutex);
-                memoryManager.pagingDeallocate(currentProcess);
-                memoryManager.writeBackingStore(currentProcess);
-            }
-            finishedProcesses.push_back(currentProcess);
-            currentProcess = nullptr;
-        } else {
-            if (!readyQueue.empty()) {
-                currentProcess->setRunning(false);
-                currentProcess->setWaiting(true);
-                coreVector[cpuIndex].process = nullptr;
-                coreVector[cpuIndex].state = CoreState::IDLE;
-                addProcessToReadyQueue(currentProcess);
-
-                currentProcess = nullptr;
-            }
+        switch (event.type) {
+            case CORE_STEP:
+                if (stepCore(event.coreIndex)) {
+                    eventQueue.schedule(event.tick + cyclesPerInstruction, CORE_STEP,
+                                        event.coreIndex);
+                } else {
+                    coreScheduled[event.coreIndex] = false;
+                }
+                break;
+            case GENERATE_PROCESS:
+                if (!schedulerTestRunning) {
+                    generatorScheduled = false;
+                    break;
+                }
+                submitDummyProcess();
+                eventQueue.schedule(event.tick + generateInterval, GENERATE_PROCESS);
+                break;
+            case MEMORY_STAMP:
+                if (!schedulerTestRunning) {
+                    stampScheduled = false;
+                    break;
+                }
+                for (const auto &core: statusBoard.readCores()) {
+                    if (core.running) {
+                        activeTicks += stampInterval;
+                    } else {
+                        idleTicks += stampInterval;
+                    }
+                }
+                recordMemoryStamp(event.tick);
+                eventQueue.schedule(event.tick + stampInterval, MEMORY_STAMP);
+                break;
+            case TIMER_TICK:
+                wakeExpired(event.tick);
+                timerScheduled = false;
+                break;
         }
     }
 }
 
 void Scheduler::startThreads() {
+  if (virtualMode) {
+    // the simulation thread picks up the generator and reporter itself
+    cv.notify_all();
+    return;
+  }
   // Start the thread for generating dummy processes
   generateThread = std::thread(&Scheduler::generateDummyProcesses, this);
   generateThread.detach();
@@ -321,13 +957,7 @@ void Scheduler::startThreads() {
 void Scheduler::taskManager() {
     while (schedulerTestRunning) {
         {
-            std::cout << "Ready Queue:" << std::endl;
-            // print ready queue
-            std::queue<Process *> tempQueue = readyQueue;
-            while (!tempQueue.empty()) {
-                // std::cout << tempQueue.front()->getProcessName() << std::endl;
-                tempQueue.pop();
-            }
+            std::cout << "Ready Queue: " << readyCount << std::endl;
             this->memoryManager.visualizeFrames();
             // print a divider
             std::cout << "----------------" << std::endl;
@@ -365,49 +995,133 @@ void Scheduler::stopSchedulerTest() { schedulerTestRunning = false; }
 
 void Scheduler::bootStrapthreads() {
   threadsContinue = true;
-  // start the scheduler thread
-  for (int i = 0; i < numCores; ++i) {
-    if (schedulingAlgorithm == "fcfs") {
-      coreVector[i].thread =
-          new std::thread(&Scheduler::runFCFSScheduler, this, i);
-    } else if (schedulingAlgorithm == "rr") {
-      if (config.getMaxOverallMemory() == config.getMemoryPerFrame()) {
-        coreVector[i].thread = new std::thread(&Scheduler::runRR, this, i);
-      } else {
-        coreVector[i].thread =
-            new std::thread(&Scheduler::runPagingRR, this, i);
-      }
-    }
-    coreVector[i].thread->detach();
+  if (schedulingAlgorithm != "fcfs" && schedulingAlgorithm != "rr" &&
+      !usesGlobalReadySet()) {
+    std::cout << "Unknown scheduler: " << schedulingAlgorithm << std::endl;
+    return;
+  }
+  if (virtualMode) {
+    simulationThread = std::thread(&Scheduler::runVirtualSimulation, this);
+    simulationThread.detach();
+    return;
   }
+  // simulated cores run on a worker pool sized to the host, not one thread
+  // per core
+  int execDelay =
+      schedulingAlgorithm == "fcfs" ? delaysPerExecution : globalExecDelay;
+  int workers = std::max(
+      1, std::min<int>(numCores, std::thread::hardware_concurrency()));
+  coreExecutor = new CoreExecutor(
+      numCores, workers, [this](int cpuIndex) { return stepCore(cpuIndex); },
+      std::chrono::milliseconds(execDelay));
+  coreExecutor->start();
+  std::thread timerThread(&Scheduler::runTimer, this);
+  timerThread.detach();
 }
 
 void Scheduler::generateReportPerCycle() {
     int rr = 0;
     while (schedulerTestRunning) {
-        for (const auto &core: coreVector) {
-            if (core.state == RUNNING) {
+        for (const auto &core: statusBoard.readCores()) {
+            if (core.running) {
                 activeTicks += 1;
             } else {
                 idleTicks += 1;
             }
         }
-        std::stringstream formatName;
-        formatName << "memory_stamp_" << rr << ".txt"; {
-            std::lock_guard<std::mutex> lock(memoryManagerMutex);
-            memoryManager.generateReport(formatName.str());
-        }
+        recordMemoryStamp(rr);
         rr += quantumCycles;
         std::this_thread::sleep_for(std::chrono::milliseconds(globalExecDelay));
     }
 }
 
+// only the snapshot is taken here; the recorder's thread writes it out
+void Scheduler::recordMemoryStamp(uint64_t cycle) {
+    stampRecorder.record(cycle, [this](MemoryStamp &stamp) {
+        memoryManager.captureStamp(stamp);
+    });
+}
+
 std::vector<Core> *Scheduler::getCoreVector() { return &coreVector; }
 
+const StatusBoard *Scheduler::getStatusBoard() const { return &statusBoard; }
+
 void Scheduler::startSchedulerTest() {
-    std::cout << "Starting Scheduler Test" << std::endl;
-    schedulerTestRunning = true;
+    std::cout << "Starting Scheduler Test" << std::endl; {
+        std::lock_guard<std::mutex> lock(mtx);
+        schedulerTestRunning = true;
+    }
     startThreads();
 }
 
 MemoryManager *Scheduler::getMemoryManager() { return &memoryManager; }
+
+const StampRecorder &Scheduler::getStampRecorder() const { return stampRecorder; }
+
+std::string Scheduler::getMemoryMode() const { return memoryMode; }
+
+bool Scheduler::isVirtualMode() const { return virtualMode; }
+
+uint64_t Scheduler::getCurrentCycle() const { return currentCycle; }
+
+/*
+ * Scheduler time in instruction ticks: the virtual clock in virtual mode,
+ * otherwise wall time divided by the per-instruction delay.
+ */
+uint64_t Scheduler::currentTick() const {
+    if (virtualMode) {
+        return currentCycle;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime);
+    int execDelay =
+            schedulingAlgorithm == "fcfs" ? delaysPerExecution : globalExecDelay;
+    return elapsed.count() / std::max(execDelay, 1);
+}
+
+int Scheduler::getReadyCount() const { return readyCount; }
+
+int Scheduler::getBlockedCount() const { return blockedCount; }
+
+int Scheduler::getMemoryWaitCount() const { return memoryWaitCount; }
+
+int Scheduler::getResidentCount() const { return residentCount; }
+
+double Scheduler::getAverageWaitingTime() const {
+    uint64_t completed = completedProcesses;
+    return completed == 0 ? 0.0 : static_cast<double>(totalWaitingTicks) / completed;
+}
+
+double Scheduler::getAverageTurnaroundTime() const {
+    uint64_t completed = completedProcesses;
+    return completed == 0 ? 0.0
+                          : static_cast<double>(totalTurnaroundTicks) / completed;
+}
+
+uint64_t Scheduler::getMissedDeadlines() const { return missedDeadlines; }
+
+uint64_t Scheduler::getRejectedProcesses() const { return rejectedProcesses; }
+
+/*
+ * One line per tenant: tickets, ticket share and the share of core ticks the
+ * tenant actually received.
+ */
+std::string Scheduler::getTenantShares() const {
+    uint64_t totalTickets = 0;
+    uint64_t totalTicks = 0;
+    for (size_t i = 0; i < tenantTickets.size(); ++i) {
+        totalTickets += tenantTickets[i];
+        totalTicks += tenantTicks[i];
+    }
+    std::ostringstream shares;
+    shares << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i < tenantTickets.size(); ++i) {
+        double ticketShare = totalTickets == 0
+                                 ? 0.0
+                                 : 100.0 * tenantTickets[i] / totalTickets;
+        double cpuShare = totalTicks == 0 ? 0.0 : 100.0 * tenantTicks[i] / totalTicks;
+        shares << "Tenant " << i << ": " << tenantTickets[i] << " tickets ("
+               << ticketShare << "%), CPU share " << cpuShare << "%\n";
+    }
+    return shares.str();
+}
@@ -0,0 +1,69 @@
+#include "headers/StampRecorder.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+
+StampRecorder::StampRecorder(const std::string &path, int capacity)
+    : path(path), ring(std::max(capacity, 1)) {}
+
+void StampRecorder::start() {
+  open();
+  std::thread writer(&StampRecorder::run, this);
+  writer.detach();
+}
+
+void StampRecorder::record(uint64_t cycle,
+                           const std::function<void(MemoryStamp &)> &fill) {
+  std::lock_guard<std::mutex> lock(producerMutex);
+  uint64_t position = tail.load(std::memory_order_relaxed);
+  uint64_t taken;
+  while (position - (taken = head.load(std::memory_order_acquire)) ==
+         ring.size()) {
+    head.wait(taken);
+  }
+  MemoryStamp &stamp = ring[position % ring.size()];
+  fill(stamp);
+  stamp.cycle = cycle;
+  tail.store(position + 1, std::memory_order_release);
+  tail.notify_one();
+}
+
+void StampRecorder::run() {
+  while (true) {
+    uint64_t end = tail.load(std::memory_order_acquire);
+    uint64_t position = head.load(std::memory_order_relaxed);
+    if (position == end) {
+      tail.wait(end);
+      continue;
+    }
+    uint64_t count = end - position;
+    buffer.clear();
+    for (; position != end; ++position) {
+      encoder.encode(ring[position % ring.size()], buffer);
+    }
+    // the stamps are copied into buffer, so their entries can be reused
+    head.store(end, std::memory_order_release);
+    head.notify_one();
+    if (file.is_open()) {
+      file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      file.flush();
+      bytesWritten += buffer.size();
+      stampsWritten += count;
+    }
+  }
+}
+
+// truncates the stamp file from a previous run and writes the header
+void StampRecorder::open() {
+  std::filesystem::path filePath(path);
+  std::error_code error;
+  if (filePath.has_parent_path()) {
+    std::filesystem::create_directories(filePath.parent_path(), error);
+  }
+  file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (file.is_open()) {
+    file << StampEncoder::HEADER;
+    bytesWritten += StampEncoder::HEADER.size();
+  }
+}
@@ -0,0 +1,69 @@
+#include "headers/MemoryStamp.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/*
+ * Renders the stamps in a memory stamp file back into the text layout of the
+ * old memory_stamp_<n>.txt files.
+ *
+ *   memoryStampRender <file>               list the stamps
+ *   memoryStampRender <file> <cycle>       print the stamp taken at cycle
+ *   memoryStampRender <file> --all [dir]   write every stamp to
+ *                                          dir/memory_stamp_<cycle>.txt
+ */
+int main(int argc, char *argv[]) {
+  if (argc < 2 || argc > 4) {
+    std::cerr << "usage: " << argv[0]
+              << " <stamp file> [<cycle> | --all [directory]]\n";
+    return 2;
+  }
+  std::ifstream in(argv[1], std::ios::binary);
+  StampDecoder decoder;
+  if (!in.is_open() || !decoder.readHeader(in)) {
+    std::cerr << argv[1] << " is not a memory stamp file\n";
+    return 1;
+  }
+
+  std::string mode = argc > 2 ? argv[2] : "";
+  bool all = mode == "--all";
+  std::filesystem::path directory = argc > 3 ? argv[3] : "memory_stamps";
+  if (all) {
+    std::filesystem::create_directories(directory);
+  }
+  uint64_t cycle = 0;
+  if (!mode.empty() && !all) {
+    cycle = std::strtoull(mode.c_str(), nullptr, 10);
+  }
+
+  MemoryStamp stamp;
+  int count = 0;
+  while (decoder.decode(in, stamp)) {
+    count++;
+    if (all) {
+      std::ofstream out(directory /
+                        ("memory_stamp_" + std::to_string(stamp.cycle) +
+                         ".txt"));
+      writeStampLayout(stamp, out);
+      out << "\n\n";
+    } else if (!mode.empty()) {
+      if (stamp.cycle == cycle) {
+        writeStampLayout(stamp, std::cout);
+        return 0;
+      }
+    } else {
+      std::cout << "cycle " << stamp.cycle << ": " << stamp.processCount
+                << " processes, " << stamp.externalFragmentation
+                << " KB external fragmentation\n";
+    }
+  }
+  if (!mode.empty() && !all) {
+    std::cerr << "no stamp taken at cycle " << cycle << "\n";
+    return 1;
+  }
+  std::cout << count << " stamps\n";
+  return 0;
+}
@@ -0,0 +1,103 @@
+#include "headers/StatusBoard.h"
+
+#include <algorithm>
+
+StatusBoard::StatusBoard(int numCores)
+    : numCores(numCores), slots(new CoreSlot[std::max(numCores, 0)]) {}
+
+StatusBoard::~StatusBoard() {
+  const FinishedRecord *record = finishedHead.load();
+  while (record != nullptr) {
+    const FinishedRecord *next = record->next;
+    delete record;
+    record = next;
+  }
+}
+
+/*
+ * Called by the core that owns the slot after every step; process is nullptr
+ * when the core is idle.
+ */
+void StatusBoard::publishCore(int coreIndex, const Process *process) {
+  CoreSlot &slot = slots[coreIndex];
+  uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+  slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.process.store(process, std::memory_order_relaxed);
+  if (process != nullptr) {
+    slot.instructionsDone.store(process->getInstructionsDone(),
+                                std::memory_order_relaxed);
+    slot.instructionsTotal.store(process->getInstructionsTotal(),
+                                 std::memory_order_relaxed);
+    slot.startTime.store(process->startTime, std::memory_order_relaxed);
+  }
+  slot.published.store(publishCount.fetch_add(1, std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+
+  slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void StatusBoard::publishFinished(const Process *process) {
+  auto *record = new FinishedRecord{
+      process->getProcessName(), process->startTime,
+      process->getInstructionsDone(), process->getInstructionsTotal(), nullptr};
+  const FinishedRecord *head = finishedHead.load(std::memory_order_relaxed);
+  do {
+    record->next = head;
+  } while (!finishedHead.compare_exchange_weak(head, record,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed));
+}
+
+CoreStatus StatusBoard::readCore(int coreIndex) const {
+  const CoreSlot &slot = slots[coreIndex];
+  CoreStatus status{};
+  uint32_t before, after;
+  do {
+    before = slot.sequence.load(std::memory_order_acquire);
+    status.process = slot.process.load(std::memory_order_relaxed);
+    status.instructionsDone =
+        slot.instructionsDone.load(std::memory_order_relaxed);
+    status.instructionsTotal =
+        slot.instructionsTotal.load(std::memory_order_relaxed);
+    status.startTime = slot.startTime.load(std::memory_order_relaxed);
+    status.published = slot.published.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    after = slot.sequence.load(std::memory_order_relaxed);
+  } while ((before & 1) != 0 || before != after);
+
+  status.coreIndex = coreIndex;
+  status.running = status.process != nullptr;
+  return status;
+}
+
+std::vector<CoreStatus> StatusBoard::readCores() const {
+  std::vector<CoreStatus> cores;
+  cores.reserve(numCores);
+  for (int i = 0; i < numCores; ++i) {
+    cores.push_back(readCore(i));
+  }
+  // A core keeps showing the process it last stepped, which by now may have
+  // been dispatched elsewhere; it is listed only where it ran last.
+  for (CoreStatus &core : cores) {
+    for (const CoreStatus &other : cores) {
+      if (core.process != nullptr && other.process == core.process &&
+          other.published > core.published) {
+        core.process = nullptr;
+      }
+    }
+  }
+  return cores;
+}
+
+std::vector<const FinishedRecord *> StatusBoard::readFinished() const {
+  std::vector<const FinishedRecord *> records;
+  for (const FinishedRecord *record =
+           finishedHead.load(std::memory_order_acquire);
+       record != nullptr; record = record->next) {
+    records.push_back(record);
+  }
+  std::reverse(records.begin(), records.end());
+  return records;
+}
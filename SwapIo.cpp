@@ -0,0 +1,130 @@
+#include "headers/SwapIo.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+SwapIo::SwapIo(SwapSpace &swapSpace, int capacity, int pageSize,
+               std::function<void(const SwapRequest &)> onPageIn)
+    : swapSpace(swapSpace), pageSize(pageSize), onPageIn(std::move(onPageIn)),
+      ring(std::max(capacity, 1)) {
+  for (SwapRequest &request : ring) {
+    request.data.resize(pageSize);
+  }
+}
+
+void SwapIo::start() {
+  std::thread worker(&SwapIo::run, this);
+  worker.detach();
+}
+
+int SwapIo::freeCapacity() const {
+  return static_cast<int>(ring.size() - (tail.load() - head.load()));
+}
+
+void SwapIo::pageOut(int slot, const char *data) {
+  uint64_t position = tail.load(std::memory_order_relaxed);
+  SwapRequest &request = ring[position % ring.size()];
+  request.kind = SwapRequest::PAGE_OUT;
+  request.slot = slot;
+  std::memcpy(request.data.data(), data, pageSize);
+  tail.store(position + 1, std::memory_order_release);
+  tail.notify_one();
+}
+
+void SwapIo::pageIn(int slot, char *target, Process *process, int page,
+                    int frame) {
+  uint64_t position = tail.load(std::memory_order_relaxed);
+  SwapRequest &request = ring[position % ring.size()];
+  request.kind = SwapRequest::PAGE_IN;
+  request.slot = slot;
+  request.target = target;
+  request.process = process;
+  request.page = page;
+  request.frame = frame;
+  tail.store(position + 1, std::memory_order_release);
+  tail.notify_one();
+}
+
+void SwapIo::exchange(int slot, char *target, Process *process, int page,
+                      int frame) {
+  uint64_t position = tail.load(std::memory_order_relaxed);
+  SwapRequest &request = ring[position % ring.size()];
+  request.kind = SwapRequest::PAGE_EXCHANGE;
+  request.slot = slot;
+  std::memcpy(request.data.data(), target, pageSize);
+  request.target = target;
+  request.process = process;
+  request.page = page;
+  request.frame = frame;
+  tail.store(position + 1, std::memory_order_release);
+  tail.notify_one();
+}
+
+void SwapIo::run() {
+  while (true) {
+    uint64_t end = tail.load(std::memory_order_acquire);
+    uint64_t position = head.load(std::memory_order_relaxed);
+    if (position == end) {
+      tail.wait(end);
+      continue;
+    }
+    for (; position != end; ++position) {
+      SwapRequest &request = ring[position % ring.size()];
+      if (request.kind == SwapRequest::PAGE_OUT) {
+        pendingWrites.push_back(&request);
+        continue;
+      }
+      flushWrites();
+      swapSpace.read(request.slot, request.target);
+      if (request.kind == SwapRequest::PAGE_EXCHANGE) {
+        pendingWrites.push_back(&request);
+      }
+      onPageIn(request);
+    }
+    flushWrites();
+    head.store(end, std::memory_order_release);
+  }
+}
+
+void SwapIo::flushWrites() {
+  if (pendingWrites.empty()) {
+    return;
+  }
+  // A slot can be freed and handed out again while a write to it is still
+  // queued, so one batch may write the same slot twice. The sort keeps
+  // submission order within a slot and only the newest write survives.
+  std::stable_sort(pendingWrites.begin(), pendingWrites.end(),
+                   [](const SwapRequest *a, const SwapRequest *b) {
+                     return a->slot < b->slot;
+                   });
+  size_t kept = 0;
+  for (size_t i = 0; i < pendingWrites.size(); ++i) {
+    if (i + 1 < pendingWrites.size() &&
+        pendingWrites[i + 1]->slot == pendingWrites[i]->slot) {
+      continue;
+    }
+    pendingWrites[kept++] = pendingWrites[i];
+  }
+  pendingWrites.resize(kept);
+  size_t first = 0;
+  while (first < pendingWrites.size()) {
+    size_t last = first + 1;
+    while (last < pendingWrites.size() &&
+           pendingWrites[last]->slot == pendingWrites[last - 1]->slot + 1) {
+      last++;
+    }
+    int count = static_cast<int>(last - first);
+    runBuffer.resize(static_cast<size_t>(count) * pageSize);
+    for (int i = 0; i < count; ++i) {
+      std::memcpy(runBuffer.data() + static_cast<size_t>(i) * pageSize,
+                  pendingWrites[first + i]->data.data(), pageSize);
+    }
+    swapSpace.write(pendingWrites[first]->slot, runBuffer.data(), count);
+    writeCalls++;
+    first = last;
+  }
+  pagesWritten += pendingWrites.size();
+  batches++;
+  pendingWrites.clear();
+}
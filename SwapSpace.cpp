@@ -0,0 +1,100 @@
+#include "headers/SwapSpace.h"
+
+#include <algorithm>
+#include <cstring>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+SwapSpace::SwapSpace(const std::string &path, int slotCount, int slotSize,
+                     bool useMmap)
+    : slots(0, std::max(slotCount, 0)), slotSize(std::max(slotSize, 1)) {
+  std::size_t size = static_cast<std::size_t>(slots.totalCount()) *
+                     static_cast<std::size_t>(this->slotSize);
+  if (size == 0) {
+    return;
+  }
+#ifndef _WIN32
+  if (useMmap) {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd != -1 && ::ftruncate(fd, static_cast<off_t>(size)) == 0) {
+      void *view =
+          ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (view != MAP_FAILED) {
+        mapped = static_cast<char *>(view);
+        mappedSize = size;
+        return;
+      }
+    }
+    // fall back to plain file I/O
+    if (fd != -1) {
+      ::close(fd);
+      fd = -1;
+    }
+  }
+#endif
+  file.open(path, std::ios::in | std::ios::out | std::ios::binary |
+                      std::ios::trunc);
+  file.seekp(static_cast<std::streamoff>(size - 1));
+  file.put('\0');
+  file.flush();
+}
+
+SwapSpace::~SwapSpace() {
+#ifndef _WIN32
+  if (mapped != nullptr) {
+    ::munmap(mapped, mappedSize);
+  }
+  if (fd != -1) {
+    ::close(fd);
+  }
+#endif
+}
+
+int SwapSpace::allocateSlot() {
+  int slot = slots.allocate();
+  if (slot != -1) {
+    used++;
+  }
+  return slot;
+}
+
+void SwapSpace::releaseSlot(int slot) {
+  if (slot < 0 || slots.isFree(slot)) {
+    return;
+  }
+  slots.release(slot);
+  used--;
+}
+
+void SwapSpace::write(int slot, const char *data, int count) {
+  std::size_t offset = static_cast<std::size_t>(slot) * slotSize;
+  std::size_t length = static_cast<std::size_t>(count) * slotSize;
+  if (mapped != nullptr) {
+    std::memcpy(mapped + offset, data, length);
+    return;
+  }
+  file.seekp(static_cast<std::streamoff>(offset));
+  file.write(data, static_cast<std::streamsize>(length));
+}
+
+void SwapSpace::read(int slot, char *data) {
+  std::size_t offset = static_cast<std::size_t>(slot) * slotSize;
+  if (mapped != nullptr) {
+    std::memcpy(data, mapped + offset, slotSize);
+    return;
+  }
+  // a seek clears the pending write, so no flush is needed in between
+  file.seekg(static_cast<std::streamoff>(offset));
+  file.read(data, slotSize);
+}
+
+int SwapSpace::usedSlots() const { return used; }
+
+int SwapSpace::freeSlots() const { return slots.totalCount() - used; }
+
+int SwapSpace::totalSlots() const { return slots.totalCount(); }
+
+bool SwapSpace::isMapped() const { return mapped != nullptr; }
@@ -0,0 +1,112 @@
+#include "headers/TimingWheel.h"
+
+#include <algorithm>
+
+void TimingWheel::schedule(Process *process, uint64_t wakeTick) {
+  process->wakeTick = wakeTick;
+  place(process, currentTick + 1);
+  count++;
+}
+
+void TimingWheel::cancel(Process *process) {
+  if (process->timerLevel == -1) {
+    return;
+  }
+  unlink(process);
+  count--;
+}
+
+void TimingWheel::advance(uint64_t now, std::vector<Process *> &expired) {
+  while (currentTick < now) {
+    if (count == 0) {
+      // nothing to cascade or fire; jump straight to now
+      currentTick = now;
+      break;
+    }
+    uint64_t tick = ++currentTick;
+    // cascade every level whose slot boundary this tick crosses, top first
+    int top = 0;
+    while (top + 1 < LEVELS &&
+           (tick & ((uint64_t(1) << (SLOT_BITS * (top + 1))) - 1)) == 0) {
+      top++;
+    }
+    for (int level = top; level >= 1; --level) {
+      int slot = static_cast<int>((tick >> (SLOT_BITS * level)) & (SLOTS - 1));
+      for (Process *process = detach(level, slot); process != nullptr;) {
+        Process *next = process->timerNext;
+        place(process, tick);
+        process = next;
+      }
+    }
+
+    int slot = static_cast<int>(tick & (SLOTS - 1));
+    for (Process *process = detach(0, slot); process != nullptr;) {
+      Process *next = process->timerNext;
+      process->timerNext = nullptr;
+      process->timerPrev = nullptr;
+      expired.push_back(process);
+      count--;
+      process = next;
+    }
+  }
+}
+
+size_t TimingWheel::size() const { return count; }
+
+bool TimingWheel::empty() const { return count == 0; }
+
+uint64_t TimingWheel::getCurrentTick() const { return currentTick; }
+
+/*
+ * Picks the lowest level whose slot is still ahead of the wheel: the wake-up
+ * tick and the current tick agree on every bit above that level.
+ */
+void TimingWheel::place(Process *process, uint64_t earliest) {
+  uint64_t tick = std::max(process->wakeTick, earliest);
+  int level = 0;
+  while (level + 1 < LEVELS && (tick >> (SLOT_BITS * (level + 1))) !=
+                                   (currentTick >> (SLOT_BITS * (level + 1)))) {
+    level++;
+  }
+  int slot = static_cast<int>((tick >> (SLOT_BITS * level)) & (SLOTS - 1));
+  link(process, level, slot);
+}
+
+void TimingWheel::link(Process *process, int level, int slot) {
+  Process *&head = slots[level][slot];
+  process->timerLevel = level;
+  process->timerSlot = slot;
+  process->timerPrev = nullptr;
+  process->timerNext = head;
+  if (head != nullptr) {
+    head->timerPrev = process;
+  }
+  head = process;
+}
+
+void TimingWheel::unlink(Process *process) {
+  if (process->timerPrev != nullptr) {
+    process->timerPrev->timerNext = process->timerNext;
+  } else {
+    slots[process->timerLevel][process->timerSlot] = process->timerNext;
+  }
+  if (process->timerNext != nullptr) {
+    process->timerNext->timerPrev = process->timerPrev;
+  }
+  process->timerNext = nullptr;
+  process->timerPrev = nullptr;
+  process->timerLevel = -1;
+  process->timerSlot = -1;
+}
+
+// Empties a slot and returns its list; the processes keep their links.
+Process *TimingWheel::detach(int level, int slot) {
+  Process *head = slots[level][slot];
+  slots[level][slot] = nullptr;
+  for (Process *process = head; process != nullptr;
+       process = process->timerNext) {
+    process->timerLevel = -1;
+    process->timerSlot = -1;
+  }
+  return head;
+}
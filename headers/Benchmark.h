@@ -0,0 +1,27 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <string>
+
+// Micro-benchmarks for the scheduler's hot paths, reachable through the
+// `benchmark` console command.
+class Benchmark {
+public:
+  static std::string runDispatchBenchmark();
+  static std::string runInterpreterBenchmark();
+  static std::string runFrameBenchmark();
+  static std::string runReplacementBenchmark();
+  static std::string runAllocationBenchmark();
+  static std::string runFramePoolBenchmark();
+
+private:
+  static double measureGlobalQueue(int cores, int processesPerCore,
+                                   int durationMs);
+  static double measureRunQueues(int cores, int processesPerCore,
+                                 int durationMs);
+  static double measureInterpreter(int budget, int durationMs);
+  static double measureFrameChurn(int frameCount, int mode, int durationMs);
+  static double measureFramePool(int cores, bool sharded, int durationMs);
+};
+
+#endif // BENCHMARK_H
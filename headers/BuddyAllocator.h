@@ -0,0 +1,54 @@
+#ifndef BUDDYALLOCATOR_H
+#define BUDDYALLOCATOR_H
+
+#include <cstdint>
+#include <vector>
+
+/*
+ * Binary buddy allocator for the "buddy" memory mode. Requests are rounded up
+ * to a power of two; a block of order k at address a has its buddy at
+ * a ^ (1 << k). Free blocks of each order sit on a doubly-linked list threaded
+ * through per-address arrays, so unlinking a buddy is O(1) and allocate and
+ * release are O(log N). Memory that is not a power of two is split into
+ * aligned power-of-two roots that never merge with each other.
+ */
+class BuddyAllocator {
+public:
+  struct Block {
+    int start;
+    int size;      // power of two
+    int requested; // 0 for a free block
+  };
+
+  explicit BuddyAllocator(int memorySize);
+
+  // start address of the new block, or -1 if no block is large enough
+  int allocate(int size);
+  void release(int start);
+
+  std::vector<Block> blocks() const; // address order
+  int usedBytes() const;             // rounded block sizes
+  int freeBytes() const;
+  int internalFragmentation() const; // rounded minus requested
+  int largestFreeBlock() const;
+  int externalFragmentation() const; // free bytes outside the largest block
+  int allocatedBlockCount() const;
+
+private:
+  static int orderFor(int size);
+  void pushFree(int start, int order);
+  void removeFree(int start, int order);
+
+  int memorySize;
+  std::vector<int> freeHeads;    // per order, -1 when empty
+  std::vector<int> nextFree;     // per address, links of free blocks
+  std::vector<int> prevFree;
+  std::vector<int8_t> freeOrder;      // order of the free block starting here
+  std::vector<int8_t> allocatedOrder; // order of the used block starting here
+  std::vector<int> requestedSize;
+  int usedTotal = 0;
+  int requestedTotal = 0;
+  int allocatedCount = 0;
+};
+
+#endif // BUDDYALLOCATOR_H
@@ -4,6 +4,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 class Config {
 public:
@@ -23,6 +24,23 @@ public:
   int getMemoryPerProcess() const;
   int getMinMemoryPerProcess() const;
   int getMaxMemoryPerProcess() const;
+  std::string getSimMode() const;
+  int getMlfqLevels() const;
+  std::vector<int> getMlfqQuantums() const;
+  int getMlfqBoostInterval() const;
+  int getMinDeadline() const;
+  int getMaxDeadline() const;
+  std::vector<int> getTenantTickets() const;
+  std::string getPagingMode() const;
+  std::string getPageReplacement() const;
+  std::string getAllocationStrategy() const;
+  std::string getMemoryMode() const;
+  int getCompactionThreshold() const;
+  int getCompactionRate() const;
+  int getSwapSize() const;
+  bool getSwapMmap() const;
+  int getSwapLatency() const;
+  int getMaxResidentProcs() const;
 
 private:
   std::string filename;
@@ -38,6 +56,26 @@ private:
   int memoryPerProcess;
   int minMemoryPerProcess;
   int maxMemoryPerProcess;
+  std::string simMode = "real";
+  int mlfqLevels = 3;
+  std::vector<int> mlfqQuantums; // empty: quantum-cycles doubled per level
+  int mlfqBoostInterval = 100;
+  int minDeadline = 0; // relative deadline range for generated processes,
+  int maxDeadline = 0; // in ticks; 0 means no deadline
+  std::vector<int> tenantTickets = {100};
+  std::string pagingMode = "process"; // "process" or "demand"
+  std::string pageReplacement = "fifo"; // fifo, lru, clock, lfu or arc
+  std::string allocationStrategy = "first-fit"; // flat mode, see FlatAllocator
+  std::string memoryMode; // flat, paging or buddy; inferred when unset
+  int compactionThreshold = 0; // percent of free memory, see MemoryManager
+  int compactionRate = 64;     // KB moved per tick, 0 means all at once
+  int swapSize = 65536;        // KB of backing store, paging mode only
+  bool swapMmap = false;       // map backing_store.bin instead of seeking
+  int swapLatency = 10;        // ticks a swap-in blocks for in virtual mode
+  int maxResidentProcs = 0;    // admission limit on processes in memory, 0: none
+                               // (demand paging: derived from the frames)
 
   void parseLine(const std::string &line);
+  static std::vector<int> parseList(const std::string &value);
+  static std::string unquote(const std::string &value);
 };
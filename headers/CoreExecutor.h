@@ -0,0 +1,59 @@
+#ifndef COREEXECUTOR_H
+#define COREEXECUTOR_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Runs any number of simulated cores on a fixed pool of worker threads.
+// A core is a task that executes one instruction per step and then waits
+// `execDelay` before its next step. Cores with nothing to run are parked
+// and cost nothing until wakeOne() hands one of them new work.
+class CoreExecutor {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  CoreExecutor(int numCores, int numWorkers,
+               std::function<bool(int)> stepFunction,
+               std::chrono::milliseconds execDelay);
+
+  void start();
+  void wakeOne();
+  void stop();
+
+  int getWorkerCount() const;
+
+private:
+  struct Timer {
+    Clock::time_point due;
+    int coreIndex;
+  };
+
+  struct Later {
+    bool operator()(const Timer &a, const Timer &b) const {
+      return a.due > b.due;
+    }
+  };
+
+  void workerLoop();
+
+  int numCores;
+  int numWorkers;
+  std::function<bool(int)> stepFunction;
+  std::chrono::milliseconds execDelay;
+
+  std::priority_queue<Timer, std::vector<Timer>, Later> timers;
+  std::vector<int> parkedCores;
+  int pendingWakes = 0; // wakeups that arrived while no core was parked
+  bool running = false;
+
+  std::mutex executorMutex;
+  std::condition_variable executorCv;
+  std::vector<std::thread> workers;
+};
+
+#endif // COREEXECUTOR_H
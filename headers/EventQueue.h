@@ -0,0 +1,42 @@
+#ifndef EVENTQUEUE_H
+#define EVENTQUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+enum SimEventType { CORE_STEP, GENERATE_PROCESS, MEMORY_STAMP, TIMER_TICK };
+
+struct SimEvent {
+  uint64_t tick;
+  uint64_t sequence; // insertion order, breaks ties between same-tick events
+  SimEventType type;
+  int coreIndex;
+};
+
+// Min-heap of pending events for the virtual-time simulation. Events that
+// fall on the same tick come out in the order they were scheduled, so a run
+// is fully deterministic.
+class EventQueue {
+public:
+  void schedule(uint64_t tick, SimEventType type, int coreIndex = -1);
+  SimEvent pop();
+  bool empty() const;
+  size_t size() const;
+
+private:
+  struct Later {
+    bool operator()(const SimEvent &a, const SimEvent &b) const {
+      if (a.tick != b.tick) {
+        return a.tick > b.tick;
+      }
+      return a.sequence > b.sequence;
+    }
+  };
+
+  std::priority_queue<SimEvent, std::vector<SimEvent>, Later> events;
+  uint64_t nextSequence = 0;
+};
+
+#endif // EVENTQUEUE_H
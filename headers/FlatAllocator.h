@@ -0,0 +1,88 @@
+#ifndef FLATALLOCATOR_H
+#define FLATALLOCATOR_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * Contiguous allocator for flat memory mode. Blocks live in an address-ordered
+ * map, so splitting and coalescing never shift anything. Free blocks are also
+ * indexed by size (best-fit, worst-fit) and by address in a max tree over
+ * start addresses (first-fit, next-fit), which keeps every fit search
+ * O(log n).
+ *
+ *   first-fit  lowest-addressed free block that is large enough
+ *   next-fit   like first-fit, but starts where the last allocation ended
+ *   best-fit   smallest free block that is large enough
+ *   worst-fit  largest free block
+ *
+ * Compaction slides allocated blocks down one at a time, so the caller can
+ * spread it over as many steps as it likes.
+ */
+class FlatAllocator {
+public:
+  struct Block {
+    int start;
+    int size;
+    bool free;
+  };
+
+  FlatAllocator(int memorySize, const std::string &strategy);
+
+  // start address of the new block, or -1 if no free block is large enough
+  int allocate(int size);
+  // frees the block starting at start and merges it with free neighbours
+  void release(int start);
+
+  // Moves the lowest allocated block that has a hole below it down into that
+  // hole. Returns the size moved (0 once memory is compact) and the block's
+  // old and new start through from and to.
+  int slideDown(int &from, int &to);
+  // size of the block the next slideDown moves, 0 if memory is compact
+  int nextSlideSize() const;
+
+  std::vector<Block> blocks() const; // address order
+  int freeBytes() const;
+  int usedBytes() const;
+  int largestFreeBlock() const;
+  int freeBlockCount() const;
+  int externalFragmentation() const; // free bytes outside the largest block
+  int fragmentationPercent() const;  // the same, as a share of free bytes
+  int allocatedBlockCount() const;
+  const std::string &getStrategy() const;
+
+  static bool isKnownStrategy(const std::string &strategy);
+
+private:
+  // max of the free block sizes stored at each start address
+  class FreeBlockTree {
+  public:
+    explicit FreeBlockTree(int addresses);
+    void set(int address, int size);
+    // lowest address >= from holding a free block of at least size, or -1
+    int findFirst(int from, int size) const;
+
+  private:
+    int findFirst(int node, int low, int high, int from, int size) const;
+    int leaves;
+    std::vector<int> tree;
+  };
+
+  int findFit(int size);
+  void addFree(int start, int size);
+  void removeFree(int start, int size);
+
+  std::string strategy;
+  int memorySize;
+  std::map<int, std::pair<int, bool>> blockMap; // start -> (size, free)
+  std::set<std::pair<int, int>> freeBySize;     // (size, start)
+  FreeBlockTree freeByAddress;
+  int nextFitStart = 0;
+  int freeTotal = 0;
+  int allocatedCount = 0;
+};
+
+#endif // FLATALLOCATOR_H
@@ -0,0 +1,37 @@
+#ifndef FRAMEALLOCATOR_H
+#define FRAMEALLOCATOR_H
+
+#include <cstdint>
+#include <vector>
+
+/*
+ * Hands out physical frame numbers in [firstFrame, firstFrame + frameCount).
+ * Free frames sit on a stack, so taking or returning a frame is O(1) no matter
+ * how many frames exist. Frames come out lowest-numbered first on a fresh
+ * allocator; after that the most recently freed frame is reused first.
+ */
+class FrameAllocator {
+public:
+  FrameAllocator(int firstFrame, int frameCount);
+
+  // Returns a free frame, or -1 when none is left.
+  int allocate();
+
+  // Reserves count frames in one call and appends them to frames. All or
+  // nothing: when fewer than count frames are free, frames is left untouched.
+  bool allocate(int count, std::vector<int> &frames);
+
+  void release(int frame);
+  void release(const std::vector<int> &frames);
+
+  bool isFree(int frame) const;
+  int freeCount() const;
+  int totalCount() const;
+
+private:
+  int firstFrame;
+  std::vector<int> freeStack;
+  std::vector<uint8_t> freeFlags; // guards against double release
+};
+
+#endif // FRAMEALLOCATOR_H
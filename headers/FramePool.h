@@ -0,0 +1,55 @@
+#ifndef FRAMEPOOL_H
+#define FRAMEPOOL_H
+
+#include "FrameAllocator.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+/*
+ * Frame allocator sharded by core. Every shard caches a few free frames
+ * behind its own mutex and refills from, or spills back to, a global
+ * FrameAllocator in batches, so cores allocating at the same time rarely
+ * touch the same lock. When the global pool runs dry the other shards'
+ * caches are drained into it before an allocation gives up.
+ *
+ * Lock order: a shard's mutex, then the global mutex. Two shard mutexes are
+ * never held at once.
+ */
+class FramePool {
+public:
+  FramePool(int frameCount, int shardCount, int cacheSize);
+
+  // Returns a free frame, or -1 when none is left anywhere.
+  int allocate(int shard);
+
+  // Appends count frames to frames. All or nothing, as in FrameAllocator.
+  bool allocate(int shard, int count, std::vector<int> &frames);
+
+  void release(int shard, int frame);
+  void release(int shard, const std::vector<int> &frames);
+
+  int freeCount() const;
+  int totalCount() const;
+
+private:
+  struct Shard {
+    std::mutex mutex;
+    std::vector<int> frames;
+  };
+
+  Shard &shardFor(int shard);
+  // take up to count frames from the global pool, called with a shard locked
+  void refill(Shard &shard, int count);
+  void spill(Shard &shard);
+  void drainShards();
+
+  FrameAllocator global;
+  std::mutex globalMutex;
+  std::vector<Shard> shards;
+  int cacheSize;
+  int frameCount;
+  std::atomic<int> freeFrames;
+};
+
+#endif // FRAMEPOOL_H
@@ -0,0 +1,92 @@
+#ifndef INTERPRETER_H
+#define INTERPRETER_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+enum Opcode : uint8_t {
+  OP_PRINT,
+  OP_DECLARE,
+  OP_ADD,
+  OP_SUBTRACT,
+  OP_SLEEP,
+  OP_FOR,
+  OP_ENDFOR,
+  OP_HALT
+};
+
+// Operand flags: by default b and c name variable slots
+constexpr uint8_t OPERAND_B_IMMEDIATE = 1;
+constexpr uint8_t OPERAND_C_IMMEDIATE = 2;
+constexpr uint8_t PRINT_VARIABLE = 4;
+
+/*
+ * One bytecode instruction, 8 bytes.
+ *   PRINT     a = slot printed when PRINT_VARIABLE is set
+ *   DECLARE   a = slot, b = value
+ *   ADD/SUB   a = slot, b/c = slot or immediate (see flags)
+ *   SLEEP     a = ticks the process sleeps; it gives the core up, is
+ *             blocked on the scheduler's timing wheel and requeued when the
+ *             wheel reaches its wake-up tick
+ *   FOR       a = repeat count
+ *   ENDFOR    a = index of the first instruction of the loop body
+ * FOR, ENDFOR and HALT are control flow and do not count as executed
+ * instructions.
+ */
+struct Instruction {
+  Opcode opcode;
+  uint8_t flags;
+  uint16_t a;
+  uint16_t b;
+  uint16_t c;
+};
+
+struct Program {
+  std::vector<Instruction> code; // always ends with OP_HALT
+  int instructionCount = 0;      // dynamic count, loops unrolled
+  int printCount = 0;            // dynamic count of PRINT instructions
+};
+
+struct PrintRecord {
+  uint16_t value;
+  bool hasValue;
+};
+
+constexpr int MAX_VARIABLES = 32;
+constexpr int MAX_FOR_DEPTH = 3;
+
+// Registers of a running program. Variables live in a flat slot array.
+struct ExecutionState {
+  struct LoopFrame {
+    uint32_t bodyStart;
+    uint16_t remaining;
+  };
+
+  uint32_t pc = 0;
+  int loopDepth = 0;
+  std::array<LoopFrame, MAX_FOR_DEPTH> loops{};
+  std::array<uint16_t, MAX_VARIABLES> slots{};
+  int sleepTicks = 0; // set by SLEEP, consumed by the caller
+  bool finished = false;
+  std::vector<PrintRecord> printLog;
+};
+
+class Interpreter {
+public:
+  // Generates a random program that executes exactly instructionCount
+  // instructions, with FOR loops nested up to MAX_FOR_DEPTH deep.
+  static Program generateProgram(int instructionCount);
+
+  // Runs up to budget instructions. Stops early after a SLEEP (sleepTicks is
+  // set) or when the program halts. Returns the number executed.
+  static int execute(const Program &program, ExecutionState &state,
+                     int budget);
+
+private:
+  static void emitBlock(Program &program, int size, int depth,
+                        int multiplier);
+  static Instruction randomLeaf();
+};
+
+#endif // INTERPRETER_H
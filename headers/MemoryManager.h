@@ -1,79 +1,178 @@
 #ifndef MEMORYMANAGER_H
 #define MEMORYMANAGER_H
 
+#include "BuddyAllocator.h"
+#include "FlatAllocator.h"
+#include "FramePool.h"
+#include "MemoryStamp.h"
+#include "PageReplacement.h"
 #include "Process.h"
+#include "SwapIo.h"
+#include "SwapSpace.h"
+#include <atomic>
+#include <cstdint>
 #include <ctime>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 class MemoryManager {
 public:
   MemoryManager(int maxMemory, int frameSize, int minMemoryPerProcess,
-                int maxMemoryPerProcess, int memPerFrame);
+                int maxMemoryPerProcess, int memPerFrame,
+                const std::string &pageReplacement = "fifo",
+                const std::string &allocationStrategy = "first-fit",
+                const std::string &memoryMode = "paging",
+                int compactionThreshold = 0, int compactionRate = 0,
+                int swapSize = 0, bool swapMmap = false, int cores = 1);
 
-  bool pagingAllocate(Process *process, int processPageReq);
+  // core picks the frame cache to allocate from or free into
+  bool pagingAllocate(Process *process, int processPageReq, int core = 0);
 
-  Process *getOldestProcessInFrameMap();
+  // swap-out victim for process paging: the least recently dispatched
+  // resident process that is neither on a core nor waiting on swap I/O
+  Process *getLeastRecentlyUsedProcess();
+  void touchResident(Process *process);
 
-  bool pagingDeallocate(Process *process);
+  // swapOut writes the resident pages to swap first, and fails if the swap
+  // space cannot take them; otherwise the process' swap slots are dropped
+  bool pagingDeallocate(Process *process, bool swapOut = false, int core = 0);
 
   bool isProcessinPagingMemory(Process *process);
 
+  // demand paging
+  void preparePageTable(Process *process);
+  bool pageIn(Process *process, int page, int core = 0);
+  void recordReferences(Process *process, bool releasePins);
+  void startSwapIo(std::function<void(Process *)> onWake);
+
   bool allocateMemory(const std::string &processName, int processSize);
   void deallocateMemory(const std::string &processName);
   bool isProcessInMemory(const std::string &processName);
-  void generateReport(const std::string &filename);
+  // moves up to compactionRate more bytes per tick of a pending flat
+  // compaction; returns true if that finished it
+  bool compactStep(uint64_t ticks = 1);
+  // takes a memory stamp and samples fragmentation for vmstat
+  void captureStamp(MemoryStamp &stamp);
   std::string getProcessMemoryBlocks();
   int getMemoryUsage(const std::string &memoryType);
   double getMemoryUtil(const std::string &memoryType);
   int getFreeMemory(const std::string &memoryType);
+  int calculateExternalFragmentation();
+  double getAverageFragmentation();
+  int getInternalFragmentation();
+  int getResidentProcessCount() const;
 
   void visualizeFrames();
 
-  int getFramesOccupiedByProcess(const std::string &processName);
+  int getFramesOccupiedByProcess(const Process *process) const;
 
   void VisualizeMemory();
 
-  void writeBackingStore(Process *process);
-
+  std::string memoryMode; // "flat", "paging" or "buddy"
   int maxMemory;
   int frameSize;
   int minMemoryPerProcess;
   int maxMemoryPerProcess;
   int memPerFrame;
-  int pagedIns = 0;
-  int pagedOuts = 0;
+  // Counters are bumped under frameMutex but atomic, so vmstat and
+  // process-smi read them without taking it.
+  std::atomic<int> pagedIns = 0;
+  std::atomic<int> pagedOuts = 0;
+  std::atomic<int> pageFaults = 0;
+  std::atomic<uint64_t> swapWrites = 0; // pages written to the swap file
+  std::atomic<uint64_t> swapReads = 0;  // pages read back from it
+  std::atomic<int> failedAllocations = 0; // no large enough block
+  std::atomic<int> fragmentationPeak = 0;
+  std::atomic<uint64_t> pageReferences = 0; // hits are references minus faults
+
+  // Flat compaction runs when an allocation fails although enough memory is
+  // free, or when fragmentation reaches compactionThreshold percent of free
+  // memory (0 disables that trigger). compactionRate bounds the bytes moved
+  // per scheduler tick, however many cores are running; 0 compacts in one go.
+  int compactionThreshold;
+  int compactionRate;
+  std::atomic<bool> compactionActive = false;
+  std::atomic<uint64_t> compactedBytes = 0;
+  std::atomic<uint64_t> compactionMoves = 0;
+  std::atomic<int> compactionPasses = 0;
+  std::atomic<int> rescuedAllocations = 0; // failed, then fit after compaction
+  std::string pageReplacement;
 
   // Paging stuff
 
   struct Frame {
-    Process *processPtr;
-    std::string processName;
-    int processPage;
-    std::time_t timestamp = 0;
+    int pid = -1;         // owning process, -1 when free
+    int processPage = -1; // virtual page of the owner held here
+    uint64_t loadTick = 0;          // memoryTick when the page came in
+    uint64_t lastReferenceTick = 0; // memoryTick of the last reference
+    bool pinned = false; // needed by a process that is on a core
     int processSizeInMem = 0;
   };
 
-  std::vector<int> freeFrameList;
-  std::unordered_map<int, Frame> processFrameMap;
+  FramePool framePool; // sharded by core, locks itself
+  std::vector<Frame> frameTable;         // indexed by frame number
+  std::vector<Process *> processTable;   // indexed by pid, resident only
+  SwapSpace swapSpace; // paging mode only
+  SwapIo *swapIo = nullptr; // null while swap I/O is synchronous
 
 private:
-  struct MemoryBlock {
-    int start;
-    int end;
-    std::string processName;
-  };
-
-  std::vector<MemoryBlock> memoryBlocks;
+  // contiguous modes: flat uses flatAllocator, buddy uses buddyAllocator
+  FlatAllocator flatAllocator;
+  BuddyAllocator buddyAllocator;
+  std::unordered_map<std::string, int> blockStart; // process -> start
+  std::unordered_map<int, std::string> blockOwner; // start -> process
+  std::unordered_set<std::string> waitingOnCompaction;
+  int compactionCredit = 0;
+  std::vector<char> physicalMemory; // frame contents, paging mode only
+  std::vector<char> exchangeBuffer; // incoming page while its slot is reused
+  std::function<void(Process *)> onSwapWake;
+  std::atomic<uint64_t> fragmentationSamples = 0; // one per memory stamp
+  std::atomic<uint64_t> fragmentationTotal = 0;
+  // Accounting for the contiguous modes, refreshed from the allocators'
+  // running totals on every allocation and release so the usage queries
+  // never take frameMutex. Paging reads the frame pool's own free count.
+  std::atomic<int> usedMemory = 0;
+  std::atomic<int> internalFragmentation = 0;
+  std::atomic<int> externalFragmentation = 0;
+  std::atomic<int> residentProcessCount = 0;
+  // Guards the frame table, resident list, replacement policy, contiguous
+  // allocators, swap slots and the producing side of swapIo. Every public
+  // method takes it, so callers need no lock of their own. Taken after the
+  // scheduler's admissionMutex and before framePool's locks.
   std::mutex frameMutex;
 
-  int findFirstFit(int processSize);
-  std::vector<int> findProcessInMap(const std::string &processName);
-  int calculateExternalFragmentation();
+  void fillStamp(MemoryStamp &stamp);
+  void compactLocked();
+  void updateAccounting();
+  char *frameBytes(int frame);
+  bool loadPage(Process *process, int page, int frame);
+  void pinTouchedPages(Process *process);
+  void completePageIn(const SwapRequest &request);
+  void savePage(Process *process, int page, int frame);
+  void releaseSwapSlots(Process *process);
+  void addResident(Process *process);
+  void removeResident(Process *process);
+  void linkResident(Process *process);
+  void unlinkResident(Process *process);
+  bool isPinned(int frame, const Process *faulting) const;
+  void recordReferencesLocked(Process *process);
+  void unpinFrames(Process *process);
+  void evictFrame(int frame);
+  bool exchangePage(Process *process, int page, int frame);
+
+  // monotonic, advanced by every page load and recorded reference
+  uint64_t memoryTick = 0;
+  // resident processes threaded through Process::residentPrev/residentNext,
+  // least recently used first; ordered by Process::residentTick
+  Process *lruHead = nullptr;
+  Process *lruTail = nullptr;
+  PageReplacementPolicy *replacementPolicy;
 };
 
 #endif // MEMORYMANAGER_H
@@ -0,0 +1,77 @@
+#ifndef MEMORYSTAMP_H
+#define MEMORYSTAMP_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Snapshot of the contiguous memory layout, as taken every quantum-cycles
+ * cycles. Flat and buddy blocks are stored the same way: requested is the
+ * size a process asked for, 0 for a free block, and equals size in flat mode.
+ */
+struct MemoryStamp {
+  struct Block {
+    int start = 0;
+    int size = 0;
+    int requested = 0;
+    std::string owner;
+
+    bool operator==(const Block &other) const = default;
+  };
+
+  uint64_t cycle = 0;
+  int64_t time = 0; // seconds since the epoch
+  bool buddy = false;
+  std::string strategy; // allocation strategy, flat only
+  int maxMemory = 0;
+  int processCount = 0;
+  int externalFragmentation = 0;
+  int internalFragmentation = 0;
+  int largestFreeBlock = 0;
+  std::vector<Block> blocks; // address order, tiling the whole memory
+};
+
+// the text layout the old memory_stamp_<n>.txt files had
+void writeStampLayout(const MemoryStamp &stamp, std::ostream &out);
+
+/*
+ * Stamp file format: a header, then one record per stamp, each encoded
+ * against the stamp before it. Numbers are LEB128 varints, signed ones
+ * zigzagged first. A record holds
+ *   - the process names seen for the first time, which get the next ids
+ *   - the deltas of the cycle, time and every counter
+ *   - how many leading blocks are unchanged, followed by the rest of the
+ *     blocks as (start delta, size, requested, owner id + 1 or 0 if free)
+ * Between two stamps usually only a few blocks near the end change, so most
+ * records are a handful of bytes.
+ */
+class StampEncoder {
+public:
+  static const std::string HEADER;
+
+  // appends the record for stamp to out
+  void encode(const MemoryStamp &stamp, std::string &out);
+
+private:
+  int nameId(const std::string &name, std::vector<const std::string *> &added);
+
+  MemoryStamp previous;
+  std::unordered_map<std::string, int> nameIds;
+};
+
+class StampDecoder {
+public:
+  // false if in does not start with a stamp file header
+  bool readHeader(std::istream &in);
+  // false at the end of the file or on a truncated record
+  bool decode(std::istream &in, MemoryStamp &stamp);
+
+private:
+  MemoryStamp previous;
+  std::vector<std::string> names;
+};
+
+#endif // MEMORYSTAMP_H
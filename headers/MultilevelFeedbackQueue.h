@@ -0,0 +1,36 @@
+#ifndef MULTILEVELFEEDBACKQUEUE_H
+#define MULTILEVELFEEDBACKQUEUE_H
+
+#include "Process.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// Ready set for the mlfq scheduler: one FIFO per priority level (0 is the
+// highest) and a bitmap of the non-empty levels, so picking the next process
+// is a find-first-set plus a pop. Not thread-safe; the scheduler guards it.
+class MultilevelFeedbackQueue {
+public:
+  static constexpr int MAX_LEVELS = 64;
+
+  explicit MultilevelFeedbackQueue(std::vector<int> levelQuantums);
+
+  void push(Process *process);
+  Process *pop();
+  void boost();
+
+  bool hasWorkAbove(int level) const;
+  int quantumFor(int level) const;
+  int levelCount() const;
+  size_t size() const;
+
+private:
+  std::vector<std::deque<Process *>> levels;
+  std::vector<int> levelQuantums;
+  std::atomic<uint64_t> nonEmptyLevels = 0; // bit i set when level i is
+                                            // non-empty, readable unlocked
+  size_t count = 0;
+};
+
+#endif // MULTILEVELFEEDBACKQUEUE_H
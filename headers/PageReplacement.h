@@ -0,0 +1,44 @@
+#ifndef PAGEREPLACEMENT_H
+#define PAGEREPLACEMENT_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/*
+ * Picks the page to evict when demand paging runs out of frames. The memory
+ * manager reports every frame that is filled, referenced or freed, and asks
+ * for a victim only when no frame is free. Every operation is O(1) or
+ * amortized O(1); victim selection skips the few pinned frames.
+ *
+ *   fifo   evicts in load order
+ *   lru    least recently referenced, intrusive list moved on every reference
+ *   clock  second chance: a reference bit and a sweeping hand
+ *   lfu    least frequently referenced, frequency buckets, ties by recency
+ *   arc    adaptive replacement cache (recency and frequency lists plus ghost
+ *          lists of recently evicted pages that tune the split between them)
+ *
+ * Not thread-safe; the memory manager guards it.
+ */
+class PageReplacementPolicy {
+public:
+  virtual ~PageReplacementPolicy() = default;
+
+  // page identifies the page independently of its frame: (pid << 32) | page
+  virtual void pageLoaded(int frame, uint64_t page) = 0;
+  virtual void pageReferenced(int frame) = 0;
+
+  // frame freed without being chosen as a victim (its process finished)
+  virtual void pageRemoved(int frame) = 0;
+
+  // Chooses and forgets a victim frame for incomingPage, never one for which
+  // pinned returns true. Returns -1 if every resident frame is pinned.
+  virtual int selectVictim(uint64_t incomingPage,
+                           const std::function<bool(int)> &pinned) = 0;
+
+  // nullptr for an unknown name
+  static PageReplacementPolicy *create(const std::string &name,
+                                       int frameCount);
+};
+
+#endif // PAGEREPLACEMENT_H
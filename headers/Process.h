@@ -8,7 +8,23 @@
 #include <vector>
 #ifndef PROCESS_H
 #define PROCESS_H
+#include "Interpreter.h"
+#include "ProcessTask.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <ctime>
+#include <span>
+
+// One entry per virtual page of a process. frame is atomic because a running
+// process checks residency while another core may be evicting the page.
+struct PageTableEntry {
+  std::atomic<int> frame = -1; // physical frame, -1 when not resident
+
+  PageTableEntry() = default;
+  PageTableEntry(const PageTableEntry &other) : frame(other.frame.load()) {}
+};
+
 class Process {
 public:
   explicit Process(std::string processName);
@@ -18,43 +34,125 @@ public:
   void setDone(bool done);
   void setRunning(bool running);
   void setWaiting(bool waiting);
+  void setBlocked(bool blocked);
   void setScreenName(std::string screenName);
   void setProcessSize(int processSize);
+  void setPriorityLevel(int level);
 
   void setInstructionsTotal(int instructions); // only called once
+  void setProgram(Program program);              // sets instructionsTotal too
+
+  // execution, driven by the core the process is dispatched to
+  void grantQuantum(int quantum);
+  ProcessEvent resume();
+
   // getters
   std::string getProcessName() const;
+  int getPid() const;
   int getInstructionsDone() const;
   int getCoreAssigned() const;
   int getProcessSize() const;
+  int getPriorityLevel() const;
 
   bool getDone() const;
   bool getRunning() const;
   bool getWaiting() const;
+  bool getBlocked() const;
 
   int getInstructionsTotal() const;
+  int getRemainingInstructions() const;
   std::string getScreenName() const;
+  // the PRINT records published so far, safe to read while the process runs
+  std::span<const PrintRecord> getPrintLog() const;
+  const Program &getProgram() const;
 
   std::time_t startTime = 0;
   std::time_t endTime = 0;
 
-  // paging stuff
-  std::vector<int> pages; // pages that the process is using
+  // scheduler ticks, for waiting and turnaround time
+  uint64_t arrivalTick = 0;
+  uint64_t finishTick = 0;
+  uint64_t serviceTicks = 0; // ticks spent on a core
+
+  // optional deadline; relative is set by whoever creates the process and
+  // becomes absolute when the scheduler admits it. 0 means none.
+  uint64_t relativeDeadline = 0;
+  uint64_t deadline = 0;
+
+  // stride scheduling: share of the CPU is tickets / total tickets
+  int tenant = 0;
+  int tickets = 100;
+  uint64_t pass = 0;
+
+  // mlfq: the last priority boost this process has seen. Only the core
+  // running it catches it up, so boosts never touch a running process.
+  uint64_t boostEpoch = 0;
+
+  // paging stuff, guarded by the memory manager
+  std::vector<PageTableEntry> pageTable;
+  int residentPages = 0;
+  // MemoryManager's resident list, least recently dispatched first
+  bool onResidentList = false;
+  Process *residentPrev = nullptr;
+  Process *residentNext = nullptr;
+  uint64_t residentTick = 0; // memory tick of the last dispatch
+  std::vector<int> swapSlots; // swap slot per page, -1 when not swapped out
+  std::atomic<int> pendingPageIns = 0; // reads queued on the swap I/O thread
+  std::atomic<bool> swapParked = false; // off the cores until they finish
+
+  // memory admission, guarded by the scheduler's admissionMutex
+  bool memoryResident = false; // counted against max-resident-procs
+  bool memoryRetry = false;    // woken from the memory-wait queue
+  int memoryStalls = 0;        // allocations tried that did not fit
+
+  // blocked on a timer: SLEEP, or swap I/O in virtual mode. The links belong
+  // to the scheduler's TimingWheel.
+  int sleepTicks = 0; // requested by the last SLEEP
+  uint64_t wakeTick = 0;
+  Process *timerNext = nullptr;
+  Process *timerPrev = nullptr;
+  int timerLevel = -1; // -1 when not on the wheel
+  int timerSlot = -1;
+
+  // demand paging: every instruction references its code page and, if it
+  // names a variable, the data page at the top of the address space
+  bool demandPaged = false;
+  int pageSize = 0;
+  std::array<int, 2> touchedPages = {-1, -1}; // pages of the next instruction
+  int faultingPage = -1;
+  std::array<int, 2> pinnedFrames = {-1, -1}; // guarded by the memory manager
+  // bumped by the core running the process, read by screen and process-smi
+  std::atomic<uint64_t> pageFaults = 0;
+  std::atomic<uint64_t> memoryReferences = 0;
+  std::vector<int> referenceLog; // pages referenced since the last flush
+  uint64_t pendingReferences = 0;
     bool isRunning = false;
 
 private:
   std::string processName;
   std::string screenName;
-  int processSize;
+  int pid; // small dense id, indexes per-process tables
+  int processSize = 0;
   int coreAssigned = -1;
+  int priorityLevel = 0; // mlfq level, 0 is the highest
 
   // BOOLEAN FLAGS
   bool isDone = false;    // when not waiting to be done by scheduler
    // when running on a core
   bool isWaiting = false; // in ready queue
+  bool isBlocked = false; // sleeping or waiting on swap I/O
                           // in main memory for scheduling
 
-  int instructionsDone = 0;
+  std::atomic<int> instructionsDone = 0; // read by process-smi while running
   int instructionsTotal = 0;
+
+  Program program;
+  ExecutionState execution;
+  // execution.printLog entries the core has published to readers
+  std::atomic<size_t> printsPublished = 0;
+  ProcessTask task; // created on first dispatch
+  ProcessTask instructionStream();
+  int findMissingPage();
+  void logReference(int page);
 };
 #endif // PROCESS_H
@@ -0,0 +1,91 @@
+#ifndef PROCESSTASK_H
+#define PROCESSTASK_H
+
+#include <climits>
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+// Why a process' instruction stream handed control back to its core.
+enum ProcessEvent {
+  INSTRUCTION_RETIRED,
+  QUANTUM_EXPIRED,
+  PROCESS_FINISHED,
+  PAGE_FAULT, // the next instruction touches a page that is not resident
+  PROCESS_BLOCKED // SLEEP retired; Process::sleepTicks says for how long
+};
+
+// Coroutine holding a process' instruction stream. The coroutine yields
+// after every retired instruction so the core can pace execution; the
+// promise keeps the quantum budget and turns the yield that exhausts it into
+// QUANTUM_EXPIRED. A page fault retires nothing and leaves the quantum
+// alone; a SLEEP retires an instruction but always reports PROCESS_BLOCKED,
+// since the process leaves its core either way. Preemption is just not
+// resuming the coroutine.
+class ProcessTask {
+public:
+  struct promise_type {
+    ProcessEvent event = INSTRUCTION_RETIRED;
+    int quantumLeft = INT_MAX;
+
+    ProcessTask get_return_object() {
+      return ProcessTask(
+          std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    std::suspend_always yield_value(ProcessEvent retired) noexcept {
+      if (retired == PAGE_FAULT) {
+        event = PAGE_FAULT;
+        return {};
+      }
+      if (retired == PROCESS_BLOCKED) {
+        --quantumLeft;
+        event = PROCESS_BLOCKED;
+        return {};
+      }
+      event = --quantumLeft <= 0 ? QUANTUM_EXPIRED : retired;
+      return {};
+    }
+    void return_void() noexcept { event = PROCESS_FINISHED; }
+    void unhandled_exception() { std::terminate(); }
+  };
+
+  ProcessTask() = default;
+  explicit ProcessTask(std::coroutine_handle<promise_type> handle)
+      : handle(handle) {}
+  ProcessTask(ProcessTask &&other) noexcept
+      : handle(std::exchange(other.handle, nullptr)) {}
+  ProcessTask &operator=(ProcessTask &&other) noexcept {
+    if (this != &other) {
+      if (handle) {
+        handle.destroy();
+      }
+      handle = std::exchange(other.handle, nullptr);
+    }
+    return *this;
+  }
+  ProcessTask(const ProcessTask &) = delete;
+  ProcessTask &operator=(const ProcessTask &) = delete;
+  ~ProcessTask() {
+    if (handle) {
+      handle.destroy();
+    }
+  }
+
+  bool valid() const { return static_cast<bool>(handle); }
+
+  void grantQuantum(int quantum) { handle.promise().quantumLeft = quantum; }
+
+  ProcessEvent resume() {
+    if (!handle.done()) {
+      handle.resume();
+    }
+    return handle.done() ? PROCESS_FINISHED : handle.promise().event;
+  }
+
+private:
+  std::coroutine_handle<promise_type> handle = nullptr;
+};
+
+#endif // PROCESSTASK_H
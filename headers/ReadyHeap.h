@@ -0,0 +1,80 @@
+#ifndef READYHEAP_H
+#define READYHEAP_H
+
+#include "Process.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Binary min-heap of ready processes. A process' key is fixed while it is
+// ready, so the heap only needs push and pop.
+template <typename Key> class ReadyHeap {
+public:
+  void push(Process *process, Key key) {
+    heap.push_back({key, process});
+    siftUp(heap.size() - 1);
+  }
+
+  Process *pop() {
+    if (heap.empty()) {
+      return nullptr;
+    }
+    Process *process = heap.front().process;
+    if (heap.size() > 1) {
+      heap.front() = std::move(heap.back());
+      heap.pop_back();
+      siftDown(0);
+    } else {
+      heap.pop_back();
+    }
+    return process;
+  }
+
+  Process *top() const { return heap.empty() ? nullptr : heap.front().process; }
+  const Key &topKey() const { return heap.front().key; }
+  bool empty() const { return heap.empty(); }
+  size_t size() const { return heap.size(); }
+
+private:
+  struct Entry {
+    Key key;
+    Process *process;
+  };
+
+  void siftUp(size_t index) {
+    Entry entry = std::move(heap[index]);
+    while (index > 0) {
+      size_t parent = (index - 1) / 2;
+      if (!(entry.key < heap[parent].key)) {
+        break;
+      }
+      heap[index] = std::move(heap[parent]);
+      index = parent;
+    }
+    heap[index] = std::move(entry);
+  }
+
+  void siftDown(size_t index) {
+    Entry entry = std::move(heap[index]);
+    size_t count = heap.size();
+    while (true) {
+      size_t child = 2 * index + 1;
+      if (child >= count) {
+        break;
+      }
+      if (child + 1 < count && heap[child + 1].key < heap[child].key) {
+        child++;
+      }
+      if (!(heap[child].key < entry.key)) {
+        break;
+      }
+      heap[index] = std::move(heap[child]);
+      index = child;
+    }
+    heap[index] = std::move(entry);
+  }
+
+  std::vector<Entry> heap;
+};
+
+#endif // READYHEAP_H
@@ -0,0 +1,29 @@
+#ifndef RUNQUEUE_H
+#define RUNQUEUE_H
+
+#include "Process.h"
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+// Ready queue owned by a single core. The owning core pushes preempted
+// processes to the back and pops from the front, so round-robin order is
+// kept per core. Idle cores steal from the front of other cores' queues; a
+// steal never blocks, it gives up if the victim's lock is held.
+class RunQueue {
+public:
+  void push(Process *process);
+  Process *pop();
+  Process *steal();
+
+  size_t size() const;
+  bool empty() const;
+
+private:
+  std::deque<Process *> processes;
+  std::mutex queueMutex;
+  std::atomic<size_t> count = 0; // readable without taking the lock
+};
+
+#endif // RUNQUEUE_H
@@ -2,39 +2,50 @@
 #define SCHEDULER_H
 
 #include "Config.h"
+#include "CoreExecutor.h"
+#include "EventQueue.h"
 #include "MemoryManager.h"
+#include "MultilevelFeedbackQueue.h"
 #include "Process.h"
+#include "ReadyHeap.h"
+#include "RunQueue.h"
+#include "StampRecorder.h"
+#include "StatusBoard.h"
+#include "TimingWheel.h"
+#include <atomic>
+#include <chrono>
+#include <climits>
 #include <condition_variable>
+#include <deque>
+#include <map>
+#include <cstdint>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <thread>
 #include <vector>
 enum CoreState { RUNNING, IDLE, STOPPED };
 struct Core {
   int coreIndex;
-  std::thread *thread;
   Process *process;
   CoreState state;
+  RunQueue *runQueue; // processes waiting for this core
 };
 
 class Scheduler {
 public:
   Scheduler(Config config, std::vector<Process *> *processVector);
 
-  void addProcessToReadyQueue(Process *process);
+  void addProcessToReadyQueue(Process *process, int cpuIndex = -1);
 
-  void addCustomProcess(Process *process);
+  bool addCustomProcess(Process *process);
 
   void generateDummyProcesses();
 
   void startSchedulerTest();
 
-  void runFCFSScheduler(int cpuIndex);
+  bool stepCore(int cpuIndex);
 
-  void runRR(int cpuIndex);
-
-  void runPagingRR(int cpuIndex);
+  void runVirtualSimulation();
 
   void startThreads();
 
@@ -47,22 +58,131 @@ public:
   void generateReportPerCycle();
 
   MemoryManager *getMemoryManager();
+  const StampRecorder &getStampRecorder() const;
+
+  std::string getMemoryMode() const;
 
   std::vector<Core> *getCoreVector();
 
+  const StatusBoard *getStatusBoard() const;
+
+  bool isVirtualMode() const;
+
+  uint64_t getCurrentCycle() const;
+
+  uint64_t currentTick() const;
+
+  double getAverageWaitingTime() const;
+  double getAverageTurnaroundTime() const;
+
+  uint64_t getMissedDeadlines() const;
+  uint64_t getRejectedProcesses() const;
+
+  std::string getTenantShares() const;
+
+  int getReadyCount() const;
+  int getBlockedCount() const;
+  int getMemoryWaitCount() const;
+  int getResidentCount() const;
+
   int globalExecDelay = 0;
   Config config;
-  std::condition_variable memoryCv;
   int totalTicks = 0;
-  int idleTicks = 0;
-  int activeTicks = 0;
+  std::atomic<int> idleTicks = 0; // read by vmstat without a lock
+  std::atomic<int> activeTicks = 0;
 
 private:
-  std::queue<Process *> readyQueue;
+  Process *createDummyProcess();
+  void submitDummyProcess();
+  bool usesGlobalReadySet() const;
+  bool passesDeadlineAdmission(Process *process);
+  Process *takeReadyProcess(int cpuIndex);
+  int quantumFor(Process *process) const;
+  bool shouldYieldCore(int cpuIndex);
+  void catchUpBoost(Process *process);
+  void onQuantumExpired(int cpuIndex);
+  bool dispatchProcess(int cpuIndex);
+  bool loadIntoMemory(Process *process, int cpuIndex);
+  void advanceCompaction();
+  bool headBlocksAdmission() const;
+  bool allocateProcessMemory(Process *process, int cpuIndex);
+  void parkOnMemory(Process *process);
+  std::vector<Process *> takeMemoryWaiters();
+  bool rotateMemoryWaiters();
+  void releaseMemory(Process *process, int cpuIndex);
+  void handlePageFault(int cpuIndex);
+  void parkOnSwap(Process *process);
+  void wakeFromSwap(Process *process);
+  void blockProcess(int cpuIndex, uint64_t ticks);
+  void sleepProcess(Process *process, uint64_t ticks);
+  void wakeExpired(uint64_t now);
+  void runTimer();
+  void finishProcess(int cpuIndex);
+  void preemptProcess(int cpuIndex);
+  void recordMemoryStamp(uint64_t cycle);
+
+  // per-core ready queues live in Core::runQueue
+  std::atomic<int> readyCount = 0;
+  std::atomic<unsigned> nextRunQueue = 0;
+
+  // blocked processes: sleepers and (virtual mode) swap I/O waits sit on the
+  // timing wheel; real-mode swap waits are woken by the swap I/O thread
+  TimingWheel timingWheel;
+  std::mutex timerMutex;
+  std::atomic<int> blockedCount = 0;
+  int swapLatency = 0; // ticks a virtual-mode swap-in blocks the process
+
+  // processes that could not get memory, or demand-paged ones whose fault
+  // found no frame to free, wait here in arrival order until a release, a
+  // finished compaction or (paging) a quantum expiry makes room. Guarded by
+  // admissionMutex, so a release cannot slip in between a failed allocation
+  // and the park.
+  std::deque<Process *> memoryWaitQueue;
+  std::atomic<int> memoryWaitCount = 0;
+  std::atomic<int> residentCount = 0;
+  std::atomic<uint64_t> lastCompactionTick = 0;
+  int maxResidentProcs = 0; // 0: no admission limit (demand paging has one)
+  // failed tries after which the head of the queue stops letting smaller
+  // processes past, so memory drains until it fits
+  static constexpr int MEMORY_STALL_LIMIT = 4;
+
+  // mlfq: one global multilevel queue instead of per-core run queues
+  MultilevelFeedbackQueue mlfq;
+  std::mutex readySetMutex;
+  int mlfqBoostInterval;
+  std::atomic<uint64_t> lastBoostTick = 0;
+  std::atomic<uint64_t> boostEpoch = 0; // bumped under readySetMutex
+
+  // sjf / srtf: ready set ordered by remaining instructions, ties by arrival
+  ReadyHeap<std::pair<int, uint64_t>> remainingTimeHeap;
+  uint64_t readySequence = 0;
+  std::atomic<int> shortestReadyRemaining = INT_MAX;
+
+  // edf: ready set ordered by absolute deadline, no-deadline work last
+  ReadyHeap<std::pair<uint64_t, uint64_t>> deadlineHeap;
+  std::atomic<uint64_t> earliestReadyDeadline = UINT64_MAX;
+  std::multimap<uint64_t, Process *> admittedDeadlines; // unfinished jobs
+  std::atomic<uint64_t> missedDeadlines = 0;
+  std::atomic<uint64_t> rejectedProcesses = 0;
+
+  // stride: ready set ordered by pass, ties by arrival
+  static constexpr uint64_t STRIDE_ONE = 1 << 20;
+  ReadyHeap<std::pair<uint64_t, uint64_t>> passHeap;
+  uint64_t globalPass = 0;
+  std::vector<int> tenantTickets;
+  std::vector<std::atomic<uint64_t>> tenantTicks; // core ticks per tenant
+
+  uint64_t ticksPerStep = 1;
+  std::atomic<uint64_t> completedProcesses = 0;
+  std::atomic<uint64_t> totalWaitingTicks = 0;
+  std::atomic<uint64_t> totalTurnaroundTicks = 0;
   std::vector<Process *> *processVector;
   std::vector<Core> coreVector;
   int numCores;
   std::string schedulingAlgorithm;
+  std::string memoryMode;
+  bool demandPaging = false;
+  static constexpr size_t REFERENCE_BATCH = 64;
   int quantumCycles;
   int batchProcessFrequency;
   int minimumInstructions;
@@ -70,19 +190,43 @@ private:
   int delaysPerExecution;
   int cycles;
 
-  bool threadsContinue = false;
-  bool schedulerTestRunning = false;
+  std::atomic<bool> threadsContinue = false;
+  std::atomic<bool> schedulerTestRunning = false;
   int processCounter = 0;
 
+  // virtual-time simulation (sim-mode "virtual")
+  bool virtualMode = false;
+  EventQueue eventQueue; // owned by the simulation thread
+  std::atomic<uint64_t> currentCycle = 0;
+  std::atomic<bool> virtualWakePending = false;
+  std::thread simulationThread;
+  std::chrono::steady_clock::time_point startTime =
+      std::chrono::steady_clock::now();
+
+  // real-time mode: simulated cores multiplexed over a worker pool
+  CoreExecutor *coreExecutor = nullptr;
+
   std::vector<Process *> finishedProcesses;
+  StatusBoard statusBoard; // what the console reads, never coreVector
   std::mutex mtx;
-  std::mutex memoryManagerMutex;
-  std::mutex allocateMemoryMutex;
-  std::mutex deallocateMemoryMutex;
+  /*
+   * Serializes memory admission: residency, the memory-wait queue, and
+   * swapping a process out to make room for another. MemoryManager locks
+   * itself, so page faults, reference batches, compaction steps and stamps
+   * do not take it. Lock order:
+   *   admissionMutex -> MemoryManager::frameMutex -> FramePool shard mutex
+   *   -> FramePool global mutex
+   * Ready-set, run-queue and timer locks are never taken while holding any
+   * of these; woken processes are requeued after admissionMutex is dropped.
+   */
+  std::mutex admissionMutex;
 
   std::condition_variable cv;
   std::thread generateThread;
   MemoryManager memoryManager;
+  // memory stamps go to memory_stamps/memory_stamps.bin; render them with
+  // memoryStampRender
+  StampRecorder stampRecorder;
 };
 
 #endif // SCHEDULER_H
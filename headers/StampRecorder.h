@@ -0,0 +1,52 @@
+#ifndef STAMPRECORDER_H
+#define STAMPRECORDER_H
+
+#include "MemoryStamp.h"
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+ * Takes memory stamps off the scheduler's hands. A stamp is filled in place
+ * in a preallocated ring, so recording one costs the caller the snapshot and
+ * nothing else; the writer thread drains the ring in batches, encodes each
+ * stamp against the one before it and appends the batch to a single stamp
+ * file with one write. Like SwapIo the ring is lock-free between the
+ * producer and the writer. When the writer falls a whole ring behind, the
+ * producer waits for it rather than dropping stamps.
+ */
+class StampRecorder {
+public:
+  StampRecorder(const std::string &path, int capacity);
+
+  // opens the stamp file and starts the writer; without a file the stamps
+  // are still taken but not kept
+  void start();
+
+  // fill runs on the caller's thread with the stamp to overwrite
+  void record(uint64_t cycle, const std::function<void(MemoryStamp &)> &fill);
+
+  std::atomic<uint64_t> stampsWritten = 0;
+  std::atomic<uint64_t> bytesWritten = 0;
+
+private:
+  void run();
+  void open();
+
+  std::string path;
+  std::ofstream file;
+  StampEncoder encoder;
+  std::string buffer;
+  // only one reporter records at a time, but an old one can still be
+  // finishing its last stamp when scheduler-test starts the next
+  std::mutex producerMutex;
+  std::vector<MemoryStamp> ring;
+  std::atomic<uint64_t> head = 0; // next stamp the writer takes
+  std::atomic<uint64_t> tail = 0; // next free entry for the producer
+};
+
+#endif // STAMPRECORDER_H
@@ -0,0 +1,69 @@
+#ifndef STATUSBOARD_H
+#define STATUSBOARD_H
+
+#include "Process.h"
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Consistent view of one core, copied out of the board.
+struct CoreStatus {
+  int coreIndex;
+  bool running;
+  // processes are never freed while listed; nullptr on a running core whose
+  // process has run on another core since
+  const Process *process;
+  int instructionsDone;
+  int instructionsTotal;
+  std::time_t startTime;
+  uint64_t published; // board-wide publish order
+};
+
+// Immutable record of a finished process.
+struct FinishedRecord {
+  std::string processName;
+  std::time_t startTime;
+  int instructionsDone;
+  int instructionsTotal;
+  const FinishedRecord *next;
+};
+
+/*
+ * Where cores publish their state for the console. Each core has a seqlock
+ * slot that only the core writes (two counter bumps per publish), and readers
+ * retry if they raced a write, so a reader never sees a torn core. Finished
+ * processes go on an append-only list whose head is swapped with a CAS;
+ * records are immutable once linked. Neither side ever takes a lock.
+ */
+class StatusBoard {
+public:
+  explicit StatusBoard(int numCores);
+  ~StatusBoard();
+
+  void publishCore(int coreIndex, const Process *process);
+  void publishFinished(const Process *process);
+
+  CoreStatus readCore(int coreIndex) const;
+  std::vector<CoreStatus> readCores() const;
+  std::vector<const FinishedRecord *> readFinished() const; // oldest first
+
+private:
+  struct CoreSlot {
+    std::atomic<uint32_t> sequence = 0; // odd while a write is in progress
+    std::atomic<const Process *> process = nullptr;
+    std::atomic<int> instructionsDone = 0;
+    std::atomic<int> instructionsTotal = 0;
+    std::atomic<std::time_t> startTime = 0;
+    std::atomic<uint64_t> published = 0;
+  };
+
+  int numCores;
+  std::unique_ptr<CoreSlot[]> slots;
+  std::atomic<uint64_t> publishCount = 0;
+  std::atomic<const FinishedRecord *> finishedHead = nullptr;
+};
+
+#endif // STATUSBOARD_H
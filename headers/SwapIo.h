@@ -0,0 +1,67 @@
+#ifndef SWAPIO_H
+#define SWAPIO_H
+
+#include "SwapSpace.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class Process;
+
+struct SwapRequest {
+  enum Kind { PAGE_OUT, PAGE_IN, PAGE_EXCHANGE };
+
+  Kind kind = PAGE_OUT;
+  int slot = -1;
+  std::vector<char> data; // page-out, exchange: copy of the evicted page
+  char *target = nullptr; // page-in, exchange: the frame being filled
+  Process *process = nullptr;
+  int page = -1;
+  int frame = -1;
+};
+
+/*
+ * Moves swap traffic off the cores. Requests go through a bounded ring that is
+ * lock-free between its single producer and the I/O thread: producers are
+ * serialized by the caller (MemoryManager holds frameMutex), the I/O thread
+ * only advances head. Each time the I/O thread wakes up it drains the ring as
+ * one batch. Page-outs are held back and written sorted by slot, with runs of
+ * adjacent slots going out in a single write. Queued page-outs are always
+ * flushed before a page-in, so a read never overtakes a write it depends on.
+ * An exchange reads a slot and then queues the evicted page's write to it.
+ */
+class SwapIo {
+public:
+  // onPageIn runs on the I/O thread once a page-in has been read
+  SwapIo(SwapSpace &swapSpace, int capacity, int pageSize,
+         std::function<void(const SwapRequest &)> onPageIn);
+
+  void start();
+
+  // requests that can still be queued; callers check before submitting
+  int freeCapacity() const;
+  void pageOut(int slot, const char *data);
+  void pageIn(int slot, char *target, Process *process, int page, int frame);
+  // page-in into target whose current contents are then written to slot
+  void exchange(int slot, char *target, Process *process, int page, int frame);
+
+  std::atomic<uint64_t> batches = 0;     // flushes that wrote something
+  std::atomic<uint64_t> writeCalls = 0;  // runs of adjacent slots written
+  std::atomic<uint64_t> pagesWritten = 0;
+
+private:
+  void run();
+  void flushWrites();
+
+  SwapSpace &swapSpace;
+  int pageSize;
+  std::function<void(const SwapRequest &)> onPageIn;
+  std::vector<SwapRequest> ring;
+  std::atomic<uint64_t> head = 0; // next request the I/O thread takes
+  std::atomic<uint64_t> tail = 0; // next free entry for the producer
+  std::vector<SwapRequest *> pendingWrites;
+  std::vector<char> runBuffer;
+};
+
+#endif // SWAPIO_H
@@ -0,0 +1,50 @@
+#ifndef SWAPSPACE_H
+#define SWAPSPACE_H
+
+#include "FrameAllocator.h"
+#include <atomic>
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+/*
+ * Fixed-size binary swap file split into page-sized slots. The file is sized
+ * once when the swap space is created, so disk usage never grows; slots are
+ * handed out by a FrameAllocator. Pages go through the file with seek and
+ * read/write, or through a shared mapping of it when useMmap is set and the
+ * platform has mmap.
+ */
+class SwapSpace {
+public:
+  SwapSpace(const std::string &path, int slotCount, int slotSize,
+            bool useMmap);
+  ~SwapSpace();
+
+  SwapSpace(const SwapSpace &) = delete;
+  SwapSpace &operator=(const SwapSpace &) = delete;
+
+  // Returns a free slot, or -1 when the swap space is full.
+  int allocateSlot();
+  void releaseSlot(int slot);
+
+  // write count adjacent slots starting at slot, or read one slot
+  void write(int slot, const char *data, int count = 1);
+  void read(int slot, char *data);
+
+  // lock-free, for vmstat
+  int usedSlots() const;
+  int freeSlots() const;
+  int totalSlots() const;
+  bool isMapped() const;
+
+private:
+  FrameAllocator slots;
+  std::atomic<int> used = 0;
+  int slotSize;
+  std::fstream file;
+  char *mapped = nullptr; // whole file when mapped
+  std::size_t mappedSize = 0;
+  int fd = -1;
+};
+
+#endif // SWAPSPACE_H
@@ -0,0 +1,47 @@
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include "Process.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Hierarchical timing wheel of blocked processes keyed by wake-up tick. Level
+ * l has 64 slots of 64^l ticks each; a process sits in the lowest level whose
+ * slot it can be told apart in, and moves down a level whenever the wheel
+ * turns past the slot above it. Slots are intrusive lists threaded through
+ * Process::timerNext/timerPrev, so schedule and cancel are O(1) and a tick
+ * only touches the processes that are due or cascade down. Wake-ups further
+ * out than the top level can span are parked in the top level and re-placed
+ * every time it comes round.
+ */
+class TimingWheel {
+public:
+  static constexpr int LEVELS = 4;
+  static constexpr int SLOT_BITS = 6;
+  static constexpr int SLOTS = 1 << SLOT_BITS;
+
+  // wake-up ticks not after now fire on the next advance
+  void schedule(Process *process, uint64_t wakeTick);
+  void cancel(Process *process);
+  // Moves the wheel up to now, appending every process that is due.
+  void advance(uint64_t now, std::vector<Process *> &expired);
+
+  size_t size() const;
+  bool empty() const;
+  uint64_t getCurrentTick() const;
+
+private:
+  void place(Process *process, uint64_t earliest);
+  void link(Process *process, int level, int slot);
+  void unlink(Process *process);
+  Process *detach(int level, int slot);
+
+  std::array<std::array<Process *, SLOTS>, LEVELS> slots{};
+  uint64_t currentTick = 0; // last tick processed
+  size_t count = 0;
+};
+
+#endif // TIMINGWHEEL_H